@@ -0,0 +1,70 @@
+
+#include "ElectronEventArena.h"
+
+#include <algorithm>
+
+ElectronEventArena::ElectronEventArena( std::size_t blockSize )
+ : blockSize_(blockSize>0?blockSize:1024), offset_(0), used_(0),
+   highWaterMark_(0), nResets_(0), nBlockAllocations_(0)
+ {}
+
+ElectronEventArena::~ElectronEventArena()
+ {
+  std::vector<Block>::iterator block ;
+  for ( block = blocks_.begin() ; block != blocks_.end() ; ++block )
+   { delete [] block->data ; }
+ }
+
+std::size_t ElectronEventArena::capacity() const
+ {
+  std::size_t total = 0 ;
+  std::vector<Block>::const_iterator block ;
+  for ( block = blocks_.begin() ; block != blocks_.end() ; ++block )
+   { total += block->size ; }
+  return total ;
+ }
+
+void ElectronEventArena::newBlock( std::size_t minSize )
+ {
+  blocks_.push_back(Block(std::max(blockSize_,minSize))) ;
+  offset_ = 0 ;
+  ++nBlockAllocations_ ;
+ }
+
+void * ElectronEventArena::allocate( std::size_t size, std::size_t alignment )
+ {
+  if (alignment==0) alignment = 1 ;
+  std::size_t padding = 0 ;
+  if (!blocks_.empty())
+   {
+    std::size_t address = reinterpret_cast<std::size_t>(blocks_.back().data+offset_) ;
+    padding = (alignment-address%alignment)%alignment ;
+   }
+  if (blocks_.empty()||(offset_+padding+size>blocks_.back().size))
+   {
+    // new blocks come from operator new[], aligned for any fundamental type
+    newBlock(size+alignment) ;
+    padding = 0 ;
+   }
+  char * result = blocks_.back().data+offset_+padding ;
+  offset_ += padding+size ;
+  used_ += padding+size ;
+  if (used_>highWaterMark_) highWaterMark_ = used_ ;
+  return result ;
+ }
+
+void ElectronEventArena::reset()
+ {
+  if (blocks_.size()>1)
+   {
+    std::size_t total = capacity() ;
+    std::vector<Block>::iterator block ;
+    for ( block = blocks_.begin() ; block != blocks_.end() ; ++block )
+     { delete [] block->data ; }
+    blocks_.clear() ;
+    newBlock(total) ;
+   }
+  offset_ = 0 ;
+  used_ = 0 ;
+  ++nResets_ ;
+ }
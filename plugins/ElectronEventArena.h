@@ -0,0 +1,106 @@
+
+#ifndef ElectronEventArena_h
+#define ElectronEventArena_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           ElectronEventArena
+//
+// Description:     Monotonic memory arena for the per-event scratch data
+//                  of a producer. Allocations are never freed one by one:
+//                  the whole arena is reset at the end of the event, and
+//                  keeps its memory for the next one.
+
+#include <cstddef>
+#include <vector>
+#include <new>
+
+class ElectronEventArena
+ {
+  public:
+
+    explicit ElectronEventArena( std::size_t blockSize =64*1024 ) ;
+    ~ElectronEventArena() ;
+
+    void * allocate( std::size_t size, std::size_t alignment ) ;
+
+    // release everything allocated since the previous reset ; if several
+    // blocks were needed, they are replaced by a single one big enough
+    void reset() ;
+
+    // statistics
+    std::size_t used() const { return used_ ; }
+    std::size_t capacity() const ;
+    std::size_t highWaterMark() const { return highWaterMark_ ; }
+    unsigned long nResets() const { return nResets_ ; }
+    unsigned long nBlockAllocations() const { return nBlockAllocations_ ; }
+
+  private:
+
+    ElectronEventArena( const ElectronEventArena & ) ;
+    ElectronEventArena & operator=( const ElectronEventArena & ) ;
+
+    struct Block
+     {
+      char * data ; std::size_t size ;
+      Block( std::size_t s ) : data(new char[s]), size(s) {}
+     } ;
+
+    void newBlock( std::size_t minSize ) ;
+
+    std::size_t blockSize_ ;
+    std::vector<Block> blocks_ ;
+    std::size_t offset_ ; // in the last block
+    std::size_t used_ ;
+    std::size_t highWaterMark_ ;
+    unsigned long nResets_ ;
+    unsigned long nBlockAllocations_ ;
+ } ;
+
+
+// std compliant allocator on top of an ElectronEventArena,
+// so that standard containers can be filled in the arena ;
+// the containers must be cleared or destroyed before the arena is reset
+template <typename T>
+class ElectronArenaAllocator
+ {
+  public:
+
+    typedef T value_type ;
+    typedef T * pointer ;
+    typedef const T * const_pointer ;
+    typedef T & reference ;
+    typedef const T & const_reference ;
+    typedef std::size_t size_type ;
+    typedef std::ptrdiff_t difference_type ;
+    template <typename U> struct rebind { typedef ElectronArenaAllocator<U> other ; } ;
+
+    explicit ElectronArenaAllocator( ElectronEventArena & arena ) : arena_(&arena) {}
+    template <typename U> ElectronArenaAllocator( const ElectronArenaAllocator<U> & other ) : arena_(other.arena()) {}
+
+    pointer allocate( size_type n, const void * =0 )
+     { return static_cast<pointer>(arena_->allocate(n*sizeof(T),alignof(T))) ; }
+    void deallocate( pointer, size_type ) {}
+
+    void construct( pointer p, const T & value ) { new (p) T(value) ; }
+    void destroy( pointer p ) { p->~T() ; }
+    size_type max_size() const { return static_cast<size_type>(-1)/sizeof(T) ; }
+    pointer address( reference x ) const { return &x ; }
+    const_pointer address( const_reference x ) const { return &x ; }
+
+    ElectronEventArena * arena() const { return arena_ ; }
+
+  private:
+
+    ElectronEventArena * arena_ ;
+ } ;
+
+template <typename T, typename U>
+inline bool operator==( const ElectronArenaAllocator<T> & a, const ElectronArenaAllocator<U> & b )
+ { return a.arena()==b.arena() ; }
+
+template <typename T, typename U>
+inline bool operator!=( const ElectronArenaAllocator<T> & a, const ElectronArenaAllocator<U> & b )
+ { return a.arena()!=b.arena() ; }
+
+#endif
@@ -0,0 +1,68 @@
+
+#include "ElectronEventGuard.h"
+
+#include "DataFormats/EgammaReco/interface/SuperCluster.h"
+#include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "RecoEgamma/EgammaElectronAlgos/interface/ElectronUtilities.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cmath>
+
+using namespace reco ;
+
+ElectronEventGuard::ElectronEventGuard( const edm::ParameterSet & config )
+ {
+  superClusters_[0] = config.getParameter<edm::InputTag>("barrelSuperClusters") ;
+  superClusters_[1] = config.getParameter<edm::InputTag>("endcapSuperClusters") ;
+  beamSpotTag_ = config.getParameter<edm::InputTag>("beamSpot") ;
+  SCEtCut_ = config.getParameter<double>("SCEtCut") ;
+  filter_ = config.getParameter<bool>("filter") ;
+  produces<bool>() ;
+ }
+
+ElectronEventGuard::~ElectronEventGuard()
+ {}
+
+// same Et computation as ElectronSeedProducer
+bool ElectronEventGuard::filter( edm::Event & event, const edm::EventSetup & )
+ {
+  edm::Handle<reco::BeamSpot> beamSpot ;
+  event.getByLabel(beamSpotTag_,beamSpot) ;
+
+  bool pass = false ;
+  for ( unsigned int i=0 ; i<2 && !pass ; i++ )
+   {
+    edm::Handle<SuperClusterCollection> clusters ;
+    if (!event.getByLabel(superClusters_[i],clusters)) continue ;
+    SuperClusterCollection::const_iterator scl ;
+    for ( scl = clusters->begin() ; scl != clusters->end() && !pass ; ++scl )
+     {
+      double sclEta = EleRelPoint(scl->position(),beamSpot->position()).eta() ;
+      pass = (scl->energy()/cosh(sclEta)>SCEtCut_) ;
+     }
+   }
+  LogDebug("ElectronEventGuard")<<"event "<<(pass?"passed":"rejected") ;
+
+  event.put(std::auto_ptr<bool>(new bool(pass))) ;
+  return (filter_?pass:true) ;
+ }
+
+bool ElectronEventGuard::passed( const edm::Event & event, const edm::InputTag & guard )
+ {
+  if (guard.label().empty()) return true ;
+  edm::Handle<bool> result ;
+  event.getByLabel(guard,result) ;
+  if (!result.isValid())
+   {
+    throw cms::Exception("Configuration")
+      << "eventGuard '" << guard.encode() << "' is not available :"
+      << " the ElectronEventGuard must run before the guarded producers,"
+      << " or the eventGuard parameter be left empty" ;
+   }
+  return *result ;
+ }
@@ -0,0 +1,47 @@
+
+#ifndef ElectronEventGuard_h
+#define ElectronEventGuard_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           ElectronEventGuard
+//
+// Description:     Looks once per event at the barrel and endcap superclusters,
+//                  and tells whether at least one of them passes the Et cut of
+//                  the ecal seeding. The result is put in the event, so that
+//                  the guarded producers can put empty collections at once,
+//                  and is also the filter decision when filter is true.
+
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+namespace edm
+ {
+  class ParameterSet ;
+ }
+
+class ElectronEventGuard : public edm::EDFilter
+ {
+  public:
+
+    explicit ElectronEventGuard( const edm::ParameterSet & ) ;
+    virtual ~ElectronEventGuard() ;
+
+    virtual bool filter( edm::Event &, const edm::EventSetup & ) override ;
+
+    // for the guarded producers : true when the guard tag is empty,
+    // or when the event passed ; throws when the tag is not empty but
+    // the guard result is not available
+    static bool passed( const edm::Event &, const edm::InputTag & guard ) ;
+
+  private:
+
+    edm::InputTag superClusters_[2] ;
+    edm::InputTag beamSpotTag_ ;
+    double SCEtCut_ ;
+    bool filter_ ;
+ } ;
+
+#endif
@@ -0,0 +1,121 @@
+
+#include "ElectronSeedPhiIndex.h"
+
+#include "ElectronTrackerModuleTable.h"
+
+#include "DataFormats/GeometryVector/interface/LocalPoint.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <algorithm>
+#include <cmath>
+
+ElectronSeedPhiIndex::ElectronSeedPhiIndex( unsigned nPhiBins )
+ : nPhiBins_(nPhiBins>0?nPhiBins:1),
+   phiBinWidth_(2.*M_PI/nPhiBins_), binBegin_(nPhiBins_+1,0)
+ {}
+
+void ElectronSeedPhiIndex::clear()
+ {
+  entries_.clear() ;
+  phi_.clear() ; key_.clear() ;
+  unplacedKey_.clear() ;
+  std::fill(binBegin_.begin(),binBegin_.end(),0) ;
+ }
+
+unsigned ElectronSeedPhiIndex::phiBin( float phi ) const
+ {
+  int bin = static_cast<int>(std::floor((phi+M_PI)/phiBinWidth_)) ;
+  bin %= static_cast<int>(nPhiBins_) ;
+  if (bin<0) bin += nPhiBins_ ;
+  return bin ;
+ }
+
+void ElectronSeedPhiIndex::build
+ ( const TrajectorySeedCollection & seeds, const ElectronTrackerModuleTable & modules, const math::XYZPoint & beamPoint )
+ {
+  clear() ;
+
+  unsigned key ;
+  TrajectorySeedCollection::const_iterator seed ;
+  for ( seed = seeds.begin(), key = 0 ; seed != seeds.end() ; ++seed, ++key )
+   {
+    TrajectorySeed::range hits = seed->recHits() ;
+    if (hits.first==hits.second)
+     { unplacedKey_.push_back(key) ; continue ; }
+    int module = modules.index(hits.first->geographicalId().rawId()) ;
+    if (module<0)
+     {
+      LogDebug("ElectronSeedPhiIndex")<<"first hit module "<<hits.first->geographicalId().rawId()
+        <<" not in the table, seed "<<key<<" given to every road" ;
+      unplacedKey_.push_back(key) ;
+      continue ;
+     }
+    LocalPoint local = hits.first->localPosition() ;
+    float x, y, z ;
+    modules.toGlobal(module,local.x(),local.y(),x,y,z) ;
+    Entry entry ;
+    entry.phi = std::atan2(y-beamPoint.y(),x-beamPoint.x()) ;
+    entry.key = key ;
+    entry.bin = phiBin(entry.phi) ;
+    entries_.push_back(entry) ;
+   }
+  std::sort(entries_.begin(),entries_.end()) ;
+
+  unsigned n = entries_.size() ;
+  phi_.resize(n) ; key_.resize(n) ;
+  for ( unsigned i=0 ; i<n ; ++i )
+   {
+    const Entry & entry = entries_[i] ;
+    phi_[i] = entry.phi ; key_[i] = entry.key ;
+    ++binBegin_[entry.bin+1] ;
+   }
+  for ( unsigned bin=0 ; bin<nPhiBins_ ; ++bin )
+   { binBegin_[bin+1] += binBegin_[bin] ; }
+ }
+
+void ElectronSeedPhiIndex::window( float phi, float dPhi, std::vector<unsigned> & keys ) const
+ {
+  keys.assign(unplacedKey_.begin(),unplacedKey_.end()) ;
+  if (key_.empty()) return ;
+
+  int firstBin = static_cast<int>(std::floor((phi-dPhi+M_PI)/phiBinWidth_)) ;
+  int lastBin = static_cast<int>(std::floor((phi+dPhi+M_PI)/phiBinWidth_)) ;
+  int nBins = std::min(lastBin-firstBin+1,static_cast<int>(nPhiBins_)) ;
+  for ( int ibin=0 ; ibin<nBins ; ++ibin )
+   {
+    int bin = (firstBin+ibin)%static_cast<int>(nPhiBins_) ;
+    if (bin<0) bin += nPhiBins_ ;
+    for ( unsigned i=binBegin_[bin] ; i<binBegin_[bin+1] ; ++i )
+     {
+      float dphi = phi_[i]-phi ;
+      if (dphi>M_PI) dphi -= 2.*M_PI ;
+      else if (dphi<-M_PI) dphi += 2.*M_PI ;
+      if (std::abs(dphi)<=dPhi) keys.push_back(key_[i]) ;
+     }
+   }
+  std::sort(keys.begin(),keys.end()) ;
+ }
+
+unsigned ElectronSeedPhiIndex::count( float phi, float dPhi ) const
+ {
+  unsigned counter = unplacedKey_.size() ;
+  if (key_.empty()) return counter ;
+
+  int firstBin = static_cast<int>(std::floor((phi-dPhi+M_PI)/phiBinWidth_)) ;
+  int lastBin = static_cast<int>(std::floor((phi+dPhi+M_PI)/phiBinWidth_)) ;
+  int nBins = std::min(lastBin-firstBin+1,static_cast<int>(nPhiBins_)) ;
+  for ( int ibin=0 ; ibin<nBins ; ++ibin )
+   {
+    int bin = (firstBin+ibin)%static_cast<int>(nPhiBins_) ;
+    if (bin<0) bin += nPhiBins_ ;
+    unsigned begin = binBegin_[bin], end = binBegin_[bin+1] ;
+    for ( unsigned i=begin ; i<end ; ++i )
+     {
+      float dphi = phi_[i]-phi ;
+      if (dphi>M_PI) dphi -= 2.*M_PI ;
+      else if (dphi<-M_PI) dphi += 2.*M_PI ;
+      if (std::abs(dphi)<=dPhi) ++counter ;
+     }
+   }
+  return counter ;
+ }
@@ -0,0 +1,65 @@
+
+#ifndef ElectronSeedPhiIndex_h
+#define ElectronSeedPhiIndex_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           ElectronSeedPhiIndex
+//
+// Description:     Per-event index of a TrajectorySeed collection, bucketed
+//                  in the phi of the first hit seen from the beam spot, so
+//                  that each supercluster only visits the seeds of its road.
+
+#include "DataFormats/TrajectorySeed/interface/TrajectorySeedCollection.h"
+#include "DataFormats/Math/interface/Point3D.h"
+
+#include <vector>
+
+class ElectronTrackerModuleTable ;
+
+class ElectronSeedPhiIndex
+ {
+  public:
+
+    explicit ElectronSeedPhiIndex( unsigned nPhiBins =64 ) ;
+
+    // to be called each time the seed collection has changed
+    void build( const TrajectorySeedCollection &, const ElectronTrackerModuleTable &, const math::XYZPoint & beamPoint ) ;
+    void clear() ;
+    unsigned size() const { return key_.size()+unplacedKey_.size() ; }
+
+    // number of seeds whose first hit is such as |dphi|<=dPhi,
+    // plus the unplaced ones
+    unsigned count( float phi, float dPhi ) const ;
+
+    // fills keys with the position, in the original collection, of the seeds
+    // whose first hit is such as |dphi|<=dPhi, and of the unplaced ones,
+    // sorted in increasing order
+    void window( float phi, float dPhi, std::vector<unsigned> & keys ) const ;
+
+  private:
+
+    struct Entry
+     {
+      unsigned bin ; float phi ; unsigned key ;
+      bool operator<( const Entry & other ) const
+       { return (bin<other.bin)||((bin==other.bin)&&(key<other.key)) ; }
+     } ;
+
+    unsigned phiBin( float phi ) const ;
+
+    unsigned nPhiBins_ ;
+    float phiBinWidth_ ;
+
+    std::vector<Entry> entries_ ; // scratch for sorting
+
+    std::vector<float> phi_ ;
+    std::vector<unsigned> key_ ;
+    std::vector<unsigned> binBegin_ ; // nPhiBins_+1 offsets in the arrays above
+
+    // seeds with no hit, or whose first hit module is not in the table :
+    // they are given to every road, as they would be without the index
+    std::vector<unsigned> unplacedKey_ ;
+ } ;
+
+#endif
@@ -18,6 +18,7 @@
 //
 
 #include "ElectronSeedProducer.h"
+#include "ElectronEventGuard.h"
 
 #include "RecoEgamma/EgammaIsolationAlgos/interface/EgammaHcalIsolation.h"
 //#include "DataFormats/RecoCandidate/interface/RecoCandidate.h"
@@ -30,6 +31,13 @@
 #include "Geometry/Records/interface/CaloGeometryRecord.h"
 #include "Geometry/Records/interface/CaloTopologyRecord.h"
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/Records/interface/IdealGeometryRecord.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+#include "RecoTracker/Record/interface/TrackerRecoGeometryRecord.h"
+#include "TrackingTools/Records/interface/TransientRecHitRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "MagneticField/Engine/interface/MagneticField.h"
 #include "RecoCaloTools/Selectors/interface/CaloConeSelector.h"
 
 #include "DataFormats/EgammaReco/interface/ElectronSeed.h"
@@ -43,16 +51,35 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/Math/interface/deltaR.h"
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Common/interface/View.h"
 
 #include <string>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace reco ;
 
 ElectronSeedProducer::ElectronSeedProducer( const edm::ParameterSet& iConfig )
  : beamSpotTag_("offlineBeamSpot"),
    //conf_(iConfig),
-   seedFilter_(0), applyHOverECut_(true), hcalHelper_(0),
-   caloGeom_(0), caloGeomCacheId_(0), caloTopo_(0), caloTopoCacheId_(0)
+   regionalCandidateMinEt_(0.), regionalDeltaR_(0.),
+   seedFilter_(0),
+   trackerGeomCacheId_(0), magFieldCacheId_(0), trackerRecoGeomCacheId_(0), transientRecHitCacheId_(0),
+   trackerTopoCacheId_(0), rebuildSeedFilterEachRun_(true),
+   skippedRegionsDeltaR_(0.), removeDuplicatedSeeds_(false),
+   mergeSeedsWithIdenticalHits_(false),
+   initialSeedsPhiRoads_(false), dynamicPhiRoad_(false),
+   lowPtThreshold_(0.), highPtThreshold_(0.), deltaPhi1Low_(0.), deltaPhi1High_(0.), sizeWindowENeg_(0.),
+   maxPhi1_(0.), bFieldZ_(0.), moduleTableCacheId_(0), bFieldCacheId_(0),
+   applyHOverECut_(true), hcalHelper_(0),
+   caloGeom_(0), caloGeomCacheId_(0), caloTopo_(0), caloTopoCacheId_(0),
+   adaptiveSeeding_(false), adaptiveMaxSuperClusters_(0), adaptiveMinInitialSeeds_(0),
+   maxSuperClusters_(0), maxSeedMatchingIterations_(0), budgeted_(false), truncated_(false)
  {
   conf_ = iConfig.getParameter<edm::ParameterSet>("SeedConfiguration") ;
 
@@ -60,11 +87,73 @@ ElectronSeedProducer::ElectronSeedProducer( const edm::ParameterSet& iConfig )
   SCEtCut_ = conf_.getParameter<double>("SCEtCut") ;
   fromTrackerSeeds_ = conf_.getParameter<bool>("fromTrackerSeeds") ;
   prefilteredSeeds_ = conf_.getParameter<bool>("preFilteredSeeds") ;
+  if (conf_.exists("rebuildSeedFilterEachRun"))
+   { rebuildSeedFilterEachRun_ = conf_.getParameter<bool>("rebuildSeedFilterEachRun") ; }
+  if (conf_.exists("adaptiveSeeding"))
+   { adaptiveSeeding_ = conf_.getParameter<bool>("adaptiveSeeding") ; }
+  if (adaptiveSeeding_)
+   {
+    adaptiveMaxSuperClusters_ = conf_.getParameter<unsigned>("adaptiveMaxSuperClusters") ;
+    adaptiveMinInitialSeeds_ = conf_.getParameter<unsigned>("adaptiveMinInitialSeeds") ;
+   }
+  nStrategyEvents_[0] = nStrategyEvents_[1] = nStrategyEvents_[2] = 0 ;
+
+  // the SeedFilter is built lazily, check now that it could be
+  if (prefilteredSeeds_||adaptiveSeeding_)
+   {
+    if ( (!conf_.exists("OrderedHitsFactoryPSet")) ||
+         (!conf_.exists("RegionPSet")) ||
+         (!conf_.exists("TTRHBuilder")) )
+     {
+      throw cms::Exception("Configuration")
+        << "preFilteredSeeds or adaptiveSeeding is set, but the SeedConfiguration"
+        << " lacks the SeedFilter parameters OrderedHitsFactoryPSet, RegionPSet and TTRHBuilder" ;
+     }
+   }
+
+  // work budget
+  if (conf_.exists("maxSuperClusters"))
+   { maxSuperClusters_ = conf_.getParameter<unsigned>("maxSuperClusters") ; }
+  if (conf_.exists("maxSeedMatchingIterations"))
+   { maxSeedMatchingIterations_ = conf_.getParameter<unsigned>("maxSeedMatchingIterations") ; }
+  budgeted_ = (maxSuperClusters_>0) || (maxSeedMatchingIterations_>0) ;
 
   // new beamSpot tag
   if (conf_.exists("beamSpot"))
    { beamSpotTag_ = conf_.getParameter<edm::InputTag>("beamSpot") ; }
 
+  // prefiltered seeds
+  if (conf_.exists("skippedRegionsDeltaR"))
+   { skippedRegionsDeltaR_ = conf_.getParameter<double>("skippedRegionsDeltaR") ; }
+  if (conf_.exists("removeDuplicatedSeeds"))
+   { removeDuplicatedSeeds_ = conf_.getParameter<bool>("removeDuplicatedSeeds") ; }
+
+  // electron seeds
+  if (conf_.exists("mergeSeedsWithIdenticalHits"))
+   { mergeSeedsWithIdenticalHits_ = conf_.getParameter<bool>("mergeSeedsWithIdenticalHits") ; }
+
+  // phi roads in the initial seeds, same windows as ElectronSeedGenerator
+  if (conf_.exists("initialSeedsPhiRoads"))
+   { initialSeedsPhiRoads_ = conf_.getParameter<bool>("initialSeedsPhiRoads") ; }
+  if (initialSeedsPhiRoads_)
+   {
+    dynamicPhiRoad_ = conf_.getParameter<bool>("dynamicPhiRoad") ;
+    if (dynamicPhiRoad_)
+     {
+      lowPtThreshold_ = conf_.getParameter<double>("LowPtThreshold") ;
+      highPtThreshold_ = conf_.getParameter<double>("HighPtThreshold") ;
+      deltaPhi1Low_ = conf_.getParameter<double>("DeltaPhi1Low") ;
+      deltaPhi1High_ = conf_.getParameter<double>("DeltaPhi1High") ;
+      sizeWindowENeg_ = conf_.getParameter<double>("SizeWindowENeg") ;
+     }
+    else
+     {
+      maxPhi1_ = std::max(
+       std::max(std::abs(conf_.getParameter<double>("ePhiMin1")),std::abs(conf_.getParameter<double>("ePhiMax1"))),
+       std::max(std::abs(conf_.getParameter<double>("pPhiMin1")),std::abs(conf_.getParameter<double>("pPhiMax1")))) ;
+     }
+   }
+
   // for H/E
 //  if (conf_.exists("applyHOverECut"))
 //   { applyHOverECut_ = conf_.getParameter<bool>("applyHOverECut") ; }
@@ -94,39 +183,164 @@ ElectronSeedProducer::ElectronSeedProducer( const edm::ParameterSet& iConfig )
   //  get collections from config'
   superClusters_[0]=iConfig.getParameter<edm::InputTag>("barrelSuperClusters") ;
   superClusters_[1]=iConfig.getParameter<edm::InputTag>("endcapSuperClusters") ;
+  if (iConfig.exists("eventGuard"))
+   { eventGuard_ = iConfig.getParameter<edm::InputTag>("eventGuard") ; }
+  if (iConfig.exists("regionalCandidates"))
+   {
+    regionalCandidates_ = iConfig.getParameter<edm::InputTag>("regionalCandidates") ;
+    regionalCandidateMinEt_ = iConfig.getParameter<double>("regionalCandidateMinEt") ;
+    regionalDeltaR_ = iConfig.getParameter<double>("regionalDeltaR") ;
+   }
 
   //register your products
   produces<ElectronSeedCollection>() ;
+  if (adaptiveSeeding_)
+   { produces<unsigned>("seedingStrategy") ; }
+  if (budgeted_)
+   { produces<bool>("truncated") ; }
 }
 
 
-void ElectronSeedProducer::beginRun(edm::Run const&, edm::EventSetup const&)
+// FIXME: because of a bug presumably in tracker seeding,
+// perhaps in CombinedHitPairGenerator, badly caching some EventSetup product,
+// the SeedFilter must be redone when the tracker conditions change.
+// By default it is still redone for each run ; with rebuildSeedFilterEachRun
+// false, it is only redone when one of the records below has a new IOV,
+// which the SeedFilterRuns Oval job compares with the former behaviour.
+void ElectronSeedProducer::endRun( edm::Run const&, edm::EventSetup const& )
  {
-  // FIXME: because of a bug presumably in tracker seeding,
-  // perhaps in CombinedHitPairGenerator, badly caching some EventSetup product,
-  // we must redo the SeedFilter for each run.
-  if (prefilteredSeeds_) seedFilter_ = new SeedFilter(conf_) ;
+  if (!rebuildSeedFilterEachRun_) return ;
+  delete seedFilter_ ;
+  seedFilter_ = 0 ;
  }
 
-void ElectronSeedProducer::endRun(edm::Run const&, edm::EventSetup const&)
+void ElectronSeedProducer::checkSeedFilter( const edm::EventSetup & iSetup )
  {
+  unsigned long long trackerGeomCacheId = iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier() ;
+  unsigned long long magFieldCacheId = iSetup.get<IdealMagneticFieldRecord>().cacheIdentifier() ;
+  unsigned long long trackerRecoGeomCacheId = iSetup.get<TrackerRecoGeometryRecord>().cacheIdentifier() ;
+  unsigned long long transientRecHitCacheId = iSetup.get<TransientRecHitRecord>().cacheIdentifier() ;
+  unsigned long long trackerTopoCacheId = iSetup.get<IdealGeometryRecord>().cacheIdentifier() ;
+  if ( seedFilter_ &&
+       trackerGeomCacheId==trackerGeomCacheId_ &&
+       magFieldCacheId==magFieldCacheId_ &&
+       trackerRecoGeomCacheId==trackerRecoGeomCacheId_ &&
+       transientRecHitCacheId==transientRecHitCacheId_ &&
+       trackerTopoCacheId==trackerTopoCacheId_ )
+   { return ; }
+
   delete seedFilter_ ;
-  seedFilter_ = 0 ;
+  seedFilter_ = new SeedFilter(conf_) ;
+  trackerGeomCacheId_ = trackerGeomCacheId ;
+  magFieldCacheId_ = magFieldCacheId ;
+  trackerRecoGeomCacheId_ = trackerRecoGeomCacheId ;
+  transientRecHitCacheId_ = transientRecHitCacheId ;
+  trackerTopoCacheId_ = trackerTopoCacheId ;
+  LogDebug("ElectronSeedProducer")<<"SeedFilter (re)built" ;
+ }
+
+// The flat module table and the field value, used for the phi roads,
+// are only computed again when their record has changed. The roads
+// assume a uniform field : the one used is the strongest found on a
+// grid covering the tracker volume crossed up to the calorimeter, so
+// that the roads are never narrower than with the real field.
+void ElectronSeedProducer::checkPhiRoadsSetup( const edm::EventSetup & iSetup )
+ {
+  unsigned long long moduleTableCacheId = iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier() ;
+  if (moduleTableCacheId!=moduleTableCacheId_)
+   {
+    edm::ESHandle<TrackerGeometry> trackerGeom ;
+    iSetup.get<TrackerDigiGeometryRecord>().get(trackerGeom) ;
+    moduleTable_.build(*trackerGeom) ;
+    moduleTableCacheId_ = moduleTableCacheId ;
+   }
+  unsigned long long bFieldCacheId = iSetup.get<IdealMagneticFieldRecord>().cacheIdentifier() ;
+  if (bFieldCacheId!=bFieldCacheId_)
+   {
+    edm::ESHandle<MagneticField> magField ;
+    iSetup.get<IdealMagneticFieldRecord>().get(magField) ;
+    float centralBz = magField->inTesla(GlobalPoint(0.,0.,0.)).z() ;
+    float minBz = centralBz, maxBz = centralBz ;
+    for ( int ir=0 ; ir<=12 ; ++ir )
+     {
+      for ( int iz=-7 ; iz<=7 ; ++iz )
+       {
+        float bz = magField->inTesla(GlobalPoint(10.*ir,0.,40.*iz)).z() ;
+        minBz = std::min(minBz,bz) ;
+        maxBz = std::max(maxBz,bz) ;
+       }
+     }
+    bFieldZ_ = std::max(std::abs(minBz),std::abs(maxBz)) ;
+    bFieldCacheId_ = bFieldCacheId ;
+    edm::LogInfo("ElectronSeedProducer|PhiRoads")
+      <<"field in the tracker volume from "<<minBz<<" to "<<maxBz
+      <<" T (central "<<centralBz<<" T), roads computed with "<<bFieldZ_<<" T" ;
+   }
  }
 
 ElectronSeedProducer::~ElectronSeedProducer()
  {
   delete hcalHelper_ ;
   delete matcher_ ;
+  delete seedFilter_ ;
+ }
+
+void ElectronSeedProducer::endJob()
+ {
+  if (adaptiveSeeding_)
+   {
+    edm::LogInfo("ElectronSeedProducer|AdaptiveSeeding")
+      <<"events without seeding: "<<nStrategyEvents_[0]
+      <<", with the initial seeds: "<<nStrategyEvents_[1]
+      <<", with the prefiltered seeds: "<<nStrategyEvents_[2] ;
+   }
  }
 
 void ElectronSeedProducer::produce(edm::Event& e, const edm::EventSetup& iSetup)
  {
   LogDebug("ElectronSeedProducer") <<"[ElectronSeedProducer::produce] entering " ;
 
+  if (!ElectronEventGuard::passed(e,eventGuard_))
+   { putEmptyProducts(e) ; return ; }
+
   edm::Handle<reco::BeamSpot> theBeamSpot ;
   e.getByLabel(beamSpotTag_,theBeamSpot) ;
 
+  // trigger candidates, in regional mode
+  readRegions(e) ;
+
+  // Et pre-filter, before any HCAL or EventSetup access
+  // (in adaptive or budget mode, all the superclusters are counted)
+  edm::Handle<SuperClusterCollection> clusters[2] ;
+  unsigned nClusters = 0 ;
+  budgetCandidates_.clear() ;
+  for ( unsigned int i=0 ; i<2 ; i++ )
+   {
+    if (!e.getByLabel(superClusters_[i],clusters[i])) continue ;
+    for ( unsigned int j=0 ; j<clusters[i]->size() && (adaptiveSeeding_||budgeted_||nClusters==0) ; ++j )
+     {
+      const SuperCluster & scl = (*clusters[i])[j] ;
+      if (passEtCut(scl,*theBeamSpot) && inRegion(scl,*theBeamSpot))
+       {
+        ++nClusters ;
+        if (budgeted_)
+         {
+          BudgetCandidate candidate ;
+          candidate.et = scl.energy()/cosh(EleRelPoint(scl.position(),theBeamSpot->position()).eta()) ;
+          candidate.collection = i ;
+          candidate.index = j ;
+          budgetCandidates_.push_back(candidate) ;
+         }
+       }
+     }
+   }
+  if (nClusters==0)
+   {
+    LogDebug("ElectronSeedProducer")<<"No supercluster above the Et cut" ;
+    putEmptyProducts(e) ;
+    return ;
+   }
+
   if (hcalHelper_)
    {
     hcalHelper_->checkSetup(iSetup) ;
@@ -145,40 +359,83 @@ void ElectronSeedProducer::produce(edm::Event& e, const edm::EventSetup& iSetup)
 
   matcher_->setupES(iSetup);
 
+  // for the phi roads
+  if (fromTrackerSeeds_ && initialSeedsPhiRoads_)
+   { checkPhiRoadsSetup(iSetup) ; }
+
+  // choice of the seeds
+  edm::Handle<TrajectorySeedCollection> hSeeds ;
+  bool prefilteredSeeds = prefilteredSeeds_ ;
+  if (fromTrackerSeeds_ && adaptiveSeeding_)
+   {
+    e.getByLabel(initialSeeds_, hSeeds);
+    prefilteredSeeds = (nClusters<=adaptiveMaxSuperClusters_) && (hSeeds->size()>=adaptiveMinInitialSeeds_) ;
+    LogDebug("ElectronSeedProducer")<<nClusters<<" superclusters and "<<hSeeds->size()<<" initial seeds: "
+      <<(prefilteredSeeds?"prefiltered":"initial")<<" seeds used" ;
+   }
+
   // get initial TrajectorySeeds if necessary
   if (fromTrackerSeeds_)
    {
-    if (!prefilteredSeeds_)
+    if (!prefilteredSeeds)
      {
-      edm::Handle<TrajectorySeedCollection> hSeeds;
-      e.getByLabel(initialSeeds_, hSeeds);
-      theInitialSeedColl = const_cast<TrajectorySeedCollection *> (hSeeds.product());
+      if (!hSeeds.isValid()) e.getByLabel(initialSeeds_, hSeeds);
+      if (initialSeedsPhiRoads_)
+       {
+        initialSeedIndex_.build(*hSeeds,moduleTable_,theBeamSpot->position()) ;
+        theInitialSeedColl = 0 ;
+       }
+      else
+       { theInitialSeedColl = const_cast<TrajectorySeedCollection *> (hSeeds.product()) ; }
      }
     else
-     { theInitialSeedColl = new TrajectorySeedCollection ; }
+     {
+      checkSeedFilter(iSetup) ;
+      theInitialSeedColl = &prefilteredSeedColl_ ;
+     }
    }
   else
    { theInitialSeedColl = 0 ; } // not needed in this case
 
+  // work budget
+  if (budgeted_)
+   {
+    unsigned nInitialSeeds = (fromTrackerSeeds_&&!prefilteredSeeds)?hSeeds->size():0 ;
+    selectClusters(clusters,*theBeamSpot,prefilteredSeeds,nInitialSeeds) ;
+   }
+
   ElectronSeedCollection * seeds = new ElectronSeedCollection ;
 
   // loop over barrel + endcap
   for (unsigned int i=0; i<2; i++)
    {
-    edm::Handle<SuperClusterCollection> clusters ;
-    if (e.getByLabel(superClusters_[i],clusters))
+    if (clusters[i].isValid())
      {
-      SuperClusterRefVector clusterRefs ;
-      std::vector<float> hoe1s, hoe2s ;
-      filterClusters(*theBeamSpot,clusters,/*mhbhe_,*/clusterRefs,hoe1s,hoe2s) ;
-      if ((fromTrackerSeeds_) && (prefilteredSeeds_))
-       { filterSeeds(e,iSetup,clusterRefs) ; }
-      matcher_->run(e,iSetup,clusterRefs,hoe1s,hoe2s,theInitialSeedColl,*seeds) ;
+      clusterRefs_.clear() ;
+      hoe1s_.clear() ;
+      hoe2s_.clear() ;
+      filterClusters(*theBeamSpot,clusters[i],selectedClusters_[i],/*mhbhe_,*/clusterRefs_,hoe1s_,hoe2s_) ;
+      if ((fromTrackerSeeds_) && (prefilteredSeeds))
+       { filterSeeds(e,iSetup,clusterRefs_) ; }
+      if ((fromTrackerSeeds_) && (initialSeedsPhiRoads_))
+       {
+        if (prefilteredSeeds)
+         {
+          initialSeedIndex_.build(prefilteredSeedColl_,moduleTable_,theBeamSpot->position()) ;
+          runInPhiRoads(e,iSetup,*theBeamSpot,0,&prefilteredSeedColl_,*seeds) ;
+         }
+        else
+         { runInPhiRoads(e,iSetup,*theBeamSpot,hSeeds.product(),0,*seeds) ; }
+       }
+      else
+       { matcher_->run(e,iSetup,clusterRefs_,hoe1s_,hoe2s_,theInitialSeedColl,*seeds) ; }
      }
    }
 
   // store the accumulated result
   std::auto_ptr<ElectronSeedCollection> pSeeds(seeds) ;
+  if (mergeSeedsWithIdenticalHits_)
+   { mergeSeedsWithIdenticalHits(*pSeeds) ; }
   ElectronSeedCollection::iterator is ;
   for ( is=pSeeds->begin() ; is!=pSeeds->end() ; is++ )
    {
@@ -191,10 +448,244 @@ void ElectronSeedProducer::produce(edm::Event& e, const edm::EventSetup& iSetup)
       << " PID "<<superCluster.id() ;
    }
   e.put(pSeeds) ;
-  if (fromTrackerSeeds_ && prefilteredSeeds_) delete theInitialSeedColl;
+  if (adaptiveSeeding_)
+   {
+    unsigned strategy = prefilteredSeeds?2:1 ;
+    ++nStrategyEvents_[strategy] ;
+    e.put(std::auto_ptr<unsigned>(new unsigned(strategy)),"seedingStrategy") ;
+   }
+  if (budgeted_)
+   { e.put(std::auto_ptr<bool>(new bool(truncated_)),"truncated") ; }
+
+  // release the scratch data
+  prefilteredSeedColl_.clear() ;
+  clusterRefs_.clear() ;
+  hoe1s_.clear() ;
+  hoe2s_.clear() ;
+  seededRegions_.clear() ;
+  regions_.clear() ;
+  initialSeedIndex_.clear() ;
+  budgetCandidates_.clear() ;
+  selectedClusters_[0].clear() ;
+  selectedClusters_[1].clear() ;
+  theInitialSeedColl = 0 ;
+ }
+
+
+void ElectronSeedProducer::putEmptyProducts( edm::Event & e )
+ {
+  e.put(std::auto_ptr<ElectronSeedCollection>(new ElectronSeedCollection)) ;
+  if (adaptiveSeeding_)
+   {
+    ++nStrategyEvents_[0] ;
+    e.put(std::auto_ptr<unsigned>(new unsigned(0)),"seedingStrategy") ;
+   }
+  if (budgeted_)
+   { e.put(std::auto_ptr<bool>(new bool(false)),"truncated") ; }
+ }
+
+
+//===============================
+// Work budget
+// - the superclusters are taken by decreasing Et
+// - the cost of a supercluster is the number of seeds it will be
+//   matched with, not known in advance for the prefiltered seeds
+//===============================
+
+void ElectronSeedProducer::selectClusters
+ ( const edm::Handle<reco::SuperClusterCollection> * clusters, const reco::BeamSpot & bs,
+   bool prefilteredSeeds, unsigned nInitialSeeds )
+ {
+  truncated_ = false ;
+  for ( unsigned int i=0 ; i<2 ; i++ )
+   {
+    selectedClusters_[i].clear() ;
+    if (clusters[i].isValid())
+     { selectedClusters_[i].resize(clusters[i]->size(),false) ; }
+   }
+
+  std::stable_sort(budgetCandidates_.begin(),budgetCandidates_.end()) ;
+  bool roads = fromTrackerSeeds_ && initialSeedsPhiRoads_ && !prefilteredSeeds ;
+  unsigned nSelected = 0, iterations = 0 ;
+  std::vector<BudgetCandidate>::const_iterator candidate ;
+  for ( candidate = budgetCandidates_.begin() ; candidate != budgetCandidates_.end() ; ++candidate )
+   {
+    if (maxSuperClusters_&&(nSelected>=maxSuperClusters_))
+     { truncated_ = true ; break ; }
+    if (maxSeedMatchingIterations_&&fromTrackerSeeds_&&!prefilteredSeeds)
+     {
+      unsigned cost = nInitialSeeds ;
+      if (roads)
+       {
+        const SuperCluster & scl = (*clusters[candidate->collection])[candidate->index] ;
+        float sclPhi = EleRelPoint(scl.position(),bs.position()).phi() ;
+        cost = initialSeedIndex_.count(sclPhi,phiRoad(scl,bs)) ;
+       }
+      // stop at the first overrun, so that no softer cluster is kept instead
+      if (iterations+cost>maxSeedMatchingIterations_)
+       { truncated_ = true ; break ; }
+      iterations += cost ;
+     }
+    selectedClusters_[candidate->collection][candidate->index] = true ;
+    ++nSelected ;
+   }
+  if (truncated_)
+   {
+    edm::LogWarning("ElectronSeedProducer|Budget")
+      <<"work budget exceeded: "<<nSelected<<" superclusters kept out of "<<budgetCandidates_.size() ;
+   }
  }
 
 
+//===============================
+// Phi roads in the initial seeds
+// - the widest first hit window of ElectronSeedGenerator,
+//   for both charges, around the supercluster phi,
+// - plus the bending between the first hit and the calorimeter
+//===============================
+
+float ElectronSeedProducer::phiRoad( const reco::SuperCluster & scl, const reco::BeamSpot & bs ) const
+ {
+  // for the beam spot spread and the propagation approximations
+  static const double margin = 0.05 ;
+
+  EleRelPoint sclPos(scl.position(),bs.position()) ;
+  double pt = scl.energy()*std::sin(sclPos.theta()) ;
+  double dphi1 = maxPhi1_ ;
+  if (dynamicPhiRoad_)
+   {
+    if (pt<lowPtThreshold_) dphi1 = deltaPhi1Low_ ;
+    else if (pt>highPtThreshold_) dphi1 = deltaPhi1High_ ;
+    else dphi1 = deltaPhi1Low_+(deltaPhi1High_-deltaPhi1Low_)*(pt-lowPtThreshold_)/(highPtThreshold_-lowPtThreshold_) ;
+    dphi1 *= std::max(sizeWindowENeg_,1.-sizeWindowENeg_) ;
+   }
+  double bend = M_PI ;
+  if (pt>0.)
+   { bend = std::asin(std::min(1.,0.003*std::abs(bFieldZ_)*sclPos.perp()/2./pt)) ; }
+  return bend+dphi1+margin ;
+ }
+
+// The roads of all the superclusters are filled first. The matcher is then
+// called once per supercluster, with the seeds of its road, in the order of
+// the initial collection, so that the output is the same as with the whole
+// collection.
+// The seeds of the event which are in at least one road are copied once,
+// whatever the number of roads they are in. The transient ones, either
+// prefiltered or those copies, are then only borrowed : swapped in the road
+// collection for the call, then swapped back, with no hit cloning.
+void ElectronSeedProducer::runInPhiRoads
+ ( edm::Event & e, const edm::EventSetup & setup, const reco::BeamSpot & bs,
+   const TrajectorySeedCollection * eventSeeds, TrajectorySeedCollection * transientSeeds,
+   reco::ElectronSeedCollection & out )
+ {
+  unsigned nInitialSeeds = transientSeeds?transientSeeds->size():eventSeeds->size() ;
+  unsigned nClusters = clusterRefs_.size() ;
+  roadKeysBegin_.assign(1,0) ;
+  roadKeys_.clear() ;
+  for ( unsigned int i=0 ; i<nClusters ; ++i )
+   {
+    const SuperCluster & scl = *clusterRefs_[i] ;
+    float sclPhi = EleRelPoint(scl.position(),bs.position()).phi() ;
+    initialSeedIndex_.window(sclPhi,phiRoad(scl,bs),roadWindow_) ;
+    roadKeys_.insert(roadKeys_.end(),roadWindow_.begin(),roadWindow_.end()) ;
+    roadKeysBegin_.push_back(roadKeys_.size()) ;
+   }
+
+  std::vector<unsigned>::iterator roadKey ;
+  if (!transientSeeds)
+   {
+    // copied in the order of the event collection, so that the keys of
+    // each road stay ordered once renumbered
+    // reserved first, so that no reallocation copies the seeds again
+    roadCopyIndex_.assign(nInitialSeeds,-1) ;
+    unsigned nRoadSeeds = 0 ;
+    for ( roadKey = roadKeys_.begin() ; roadKey != roadKeys_.end() ; ++roadKey )
+     {
+      if (roadCopyIndex_[*roadKey]==0) continue ;
+      roadCopyIndex_[*roadKey] = 0 ;
+      ++nRoadSeeds ;
+     }
+    roadCopiedSeedColl_.clear() ;
+    roadCopiedSeedColl_.reserve(nRoadSeeds) ;
+    for ( unsigned int j=0 ; j<nInitialSeeds ; ++j )
+     {
+      if (roadCopyIndex_[j]<0) continue ;
+      roadCopyIndex_[j] = roadCopiedSeedColl_.size() ;
+      roadCopiedSeedColl_.push_back((*eventSeeds)[j]) ;
+     }
+    for ( roadKey = roadKeys_.begin() ; roadKey != roadKeys_.end() ; ++roadKey )
+     { *roadKey = roadCopyIndex_[*roadKey] ; }
+    transientSeeds = &roadCopiedSeedColl_ ;
+   }
+
+  for ( unsigned int i=0 ; i<nClusters ; ++i )
+   {
+    std::vector<unsigned>::const_iterator roadBegin = roadKeys_.begin()+roadKeysBegin_[i] ;
+    std::vector<unsigned>::const_iterator roadEnd = roadKeys_.begin()+roadKeysBegin_[i+1] ;
+    LogDebug("ElectronSeedProducer")<<"Seeds in the phi road: "<<(roadEnd-roadBegin)<<" out of "<<nInitialSeeds ;
+    if (roadBegin==roadEnd) continue ;
+
+    std::vector<unsigned>::const_iterator key ;
+    roadSeedColl_.resize(roadEnd-roadBegin) ;
+    unsigned k = 0 ;
+    for ( key = roadBegin ; key != roadEnd ; ++key, ++k )
+     { roadSeedColl_[k].swap((*transientSeeds)[*key]) ; }
+    roadClusterRefs_.clear() ;
+    roadClusterRefs_.push_back(clusterRefs_[i]) ;
+    roadHoe1s_.assign(1,hoe1s_[i]) ;
+    roadHoe2s_.assign(1,hoe2s_[i]) ;
+    matcher_->run(e,setup,roadClusterRefs_,roadHoe1s_,roadHoe2s_,&roadSeedColl_,out) ;
+    for ( key = roadBegin, k = 0 ; key != roadEnd ; ++key, ++k )
+     { roadSeedColl_[k].swap((*transientSeeds)[*key]) ; }
+   }
+  roadSeedColl_.clear() ;
+  roadCopiedSeedColl_.clear() ;
+  roadClusterRefs_.clear() ;
+  roadKeys_.clear() ;
+ }
+
+
+bool ElectronSeedProducer::passEtCut( const reco::SuperCluster & scl, const reco::BeamSpot & bs ) const
+ {
+  double sclEta = EleRelPoint(scl.position(),bs.position()).eta() ;
+  return (scl.energy()/cosh(sclEta)>SCEtCut_) ;
+ }
+
+//===============================
+// Regional mode
+// - the superclusters must be within regionalDeltaR
+//   of a trigger candidate above regionalCandidateMinEt
+//===============================
+
+void ElectronSeedProducer::readRegions( edm::Event & e )
+ {
+  regions_.clear() ;
+  if (regionalCandidates_.label().empty()) return ;
+  edm::Handle<edm::View<reco::Candidate> > candidates ;
+  e.getByLabel(regionalCandidates_,candidates) ;
+  edm::View<reco::Candidate>::const_iterator candidate ;
+  for ( candidate = candidates->begin() ; candidate != candidates->end() ; ++candidate )
+   {
+    if (candidate->et()<regionalCandidateMinEt_) continue ;
+    regions_.push_back(std::make_pair(candidate->eta(),candidate->phi())) ;
+   }
+  LogDebug("ElectronSeedProducer")<<"Regions from trigger candidates: "<<regions_.size() ;
+ }
+
+// same beamspot relative direction as the Et cut and the phi roads
+bool ElectronSeedProducer::inRegion( const reco::SuperCluster & scl, const reco::BeamSpot & bs ) const
+ {
+  if (regionalCandidates_.label().empty()) return true ;
+  EleRelPoint sclPos(scl.position(),bs.position()) ;
+  std::vector<std::pair<float,float> >::const_iterator region ;
+  for ( region = regions_.begin() ; region != regions_.end() ; ++region )
+   {
+    if (reco::deltaR(sclPos.eta(),sclPos.phi(),region->first,region->second)<regionalDeltaR_)
+     { return true ; }
+   }
+  return false ;
+ }
+
 //===============================
 // Filter the superclusters
 // - with EtCut
@@ -204,14 +695,15 @@ void ElectronSeedProducer::produce(edm::Event& e, const edm::EventSetup& iSetup)
 void ElectronSeedProducer::filterClusters
  ( const reco::BeamSpot & bs,
    const edm::Handle<reco::SuperClusterCollection> & superClusters,
+   const std::vector<bool> & selected,
    /*HBHERecHitMetaCollection * mhbhe,*/ SuperClusterRefVector & sclRefs,
    std::vector<float> & hoe1s, std::vector<float> & hoe2s )
  {
   for (unsigned int i=0;i<superClusters->size();++i)
    {
+    if (!selected.empty() && !selected[i]) continue ;
     const SuperCluster & scl = (*superClusters)[i] ;
-    double sclEta = EleRelPoint(scl.position(),bs.position()).eta() ;
-    if (scl.energy()/cosh(sclEta)>SCEtCut_)
+    if (passEtCut(scl,bs) && inRegion(scl,bs))
      {
 //      if ((applyHOverECut_==true)&&((hcalHelper_->hcalESum(scl)/scl.energy()) > maxHOverE_))
 //       { continue ; }
@@ -251,7 +743,157 @@ void ElectronSeedProducer::filterSeeds
  {
   for ( unsigned int i=0 ; i<sclRefs.size() ; ++i )
    {
+    // a supercluster close to an already seeded one gets no region of its
+    // own ; SeedFilter only builds a region from one supercluster, so the
+    // seeded one cannot be widened, and the hits seen only from the skipped
+    // supercluster are lost
+    if (skippedRegionsDeltaR_>0.)
+     {
+      float eta = sclRefs[i]->eta(), phi = sclRefs[i]->phi() ;
+      bool skipped = false ;
+      std::vector<std::pair<float,float> >::const_iterator region ;
+      for ( region = seededRegions_.begin() ; region != seededRegions_.end() ; ++region )
+       {
+        if (reco::deltaR(eta,phi,region->first,region->second)<skippedRegionsDeltaR_)
+         { skipped = true ; break ; }
+       }
+      if (skipped)
+       {
+        LogDebug("ElectronSeedProducer")<<"Region skipped, close to a previous one" ;
+        continue ;
+       }
+      seededRegions_.push_back(std::make_pair(eta,phi)) ;
+     }
     seedFilter_->seeds(event,setup,sclRefs[i],theInitialSeedColl) ;
     LogDebug("ElectronSeedProducer")<<"Number of Seeds: "<<theInitialSeedColl->size() ;
    }
+  if (removeDuplicatedSeeds_)
+   { removeDuplicatedSeeds(*theInitialSeedColl) ; }
+ }
+
+namespace
+ {
+  bool sameHits( const TrajectorySeed & seed1, const TrajectorySeed & seed2 )
+   {
+    if (seed1.nHits()!=seed2.nHits()) return false ;
+    TrajectorySeed::range hits1 = seed1.recHits(), hits2 = seed2.recHits() ;
+    TrajectorySeed::const_iterator hit1, hit2 ;
+    for ( hit1 = hits1.first, hit2 = hits2.first ; hit1 != hits1.second ; ++hit1, ++hit2 )
+     { if (!hit1->sharesInput(&*hit2,TrackingRecHit::all)) return false ; }
+    return true ;
+   }
+
+  bool sameSeed( const TrajectorySeed & seed1, const TrajectorySeed & seed2 )
+   {
+    if (seed1.direction()!=seed2.direction()) return false ;
+    const PTrajectoryStateOnDet & state1 = seed1.startingState() ;
+    const PTrajectoryStateOnDet & state2 = seed2.startingState() ;
+    if (state1.detId()!=state2.detId()) return false ;
+    if (!(state1.parameters().position()==state2.parameters().position())) return false ;
+    if (!(state1.parameters().momentum()==state2.parameters().momentum())) return false ;
+    if (state1.parameters().charge()!=state2.parameters().charge()) return false ;
+    return sameHits(seed1,seed2) ;
+   }
+
+  bool sameClusterAndHits( const reco::ElectronSeed & seed1, const reco::ElectronSeed & seed2 )
+   { return (seed1.caloCluster()==seed2.caloCluster()) && sameHits(seed1,seed2) ; }
+
+  bool hasCharge( float dPhi1, float dPhi2 )
+   {
+    return (dPhi1!=std::numeric_limits<float>::infinity())||
+           (dPhi2!=std::numeric_limits<float>::infinity()) ;
+   }
+ }
+
+// Fills duplicateOf_ for each seed, and returns the number of duplicates.
+// The seeds are grouped by first hit module and number of hits before
+// being compared.
+template <typename Seed, typename SameSeed>
+unsigned ElectronSeedProducer::findDuplicatedSeeds( const std::vector<Seed> & seeds, SameSeed same )
+ {
+  unsigned nSeeds = seeds.size() ;
+  duplicateOf_.assign(nSeeds,-1) ;
+  if (nSeeds<2) return 0 ;
+
+  seedKeys_.resize(nSeeds) ;
+  for ( unsigned i=0 ; i<nSeeds ; ++i )
+   {
+    SeedKey & key = seedKeys_[i] ;
+    TrajectorySeed::range hits = seeds[i].recHits() ;
+    key.firstDetId = (hits.first!=hits.second)?hits.first->geographicalId().rawId():0 ;
+    key.nHits = seeds[i].nHits() ;
+    key.index = i ;
+   }
+  std::sort(seedKeys_.begin(),seedKeys_.end()) ;
+
+  unsigned nDuplicated = 0 ;
+  for ( unsigned first=0, last ; first<nSeeds ; first=last )
+   {
+    for ( last=first+1 ; last<nSeeds &&
+          seedKeys_[last].firstDetId==seedKeys_[first].firstDetId &&
+          seedKeys_[last].nHits==seedKeys_[first].nHits ; ++last ) {}
+    for ( unsigned i=first+1 ; i<last ; ++i )
+     {
+      for ( unsigned j=first ; j<i ; ++j )
+       {
+        if (duplicateOf_[seedKeys_[j].index]>=0) continue ;
+        if (same(seeds[seedKeys_[j].index],seeds[seedKeys_[i].index]))
+         { duplicateOf_[seedKeys_[i].index] = seedKeys_[j].index ; ++nDuplicated ; break ; }
+       }
+     }
+   }
+  return nDuplicated ;
+ }
+
+// Overlapping regions give the same seeds several times. The first
+// occurrence of each seed is kept, and the collection order is preserved.
+void ElectronSeedProducer::removeDuplicatedSeeds( TrajectorySeedCollection & seeds )
+ {
+  unsigned nSeeds = seeds.size() ;
+  unsigned nDuplicated = findDuplicatedSeeds(seeds,sameSeed) ;
+  if (nDuplicated>0)
+   {
+    unsigned kept = 0 ;
+    for ( unsigned i=0 ; i<nSeeds ; ++i )
+     {
+      if (duplicateOf_[i]>=0) continue ;
+      if (kept!=i) seeds[kept].swap(seeds[i]) ;
+      ++kept ;
+     }
+    seeds.erase(seeds.begin()+kept,seeds.end()) ;
+   }
+  LogDebug("ElectronSeedProducer")<<"Removed "<<nDuplicated<<" duplicated seeds out of "<<nSeeds ;
+ }
+
+// Electron seeds of the same supercluster with identical hits would be
+// built independently by the CKF, and all but one of their tracks thrown
+// away by the trajectory cleaner. Only the first one is kept, and the charge
+// hypotheses of the others are added to it. Seeds of different superclusters
+// are all kept, since each one brings its supercluster to GSF tracking.
+void ElectronSeedProducer::mergeSeedsWithIdenticalHits( reco::ElectronSeedCollection & seeds )
+ {
+  unsigned nSeeds = seeds.size() ;
+  unsigned nDuplicated = findDuplicatedSeeds(seeds,sameClusterAndHits) ;
+  if (nDuplicated==0) return ;
+
+  for ( unsigned i=0 ; i<nSeeds ; ++i )
+   {
+    if (duplicateOf_[i]<0) continue ;
+    const ElectronSeed & duplicate = seeds[i] ;
+    ElectronSeed & original = seeds[duplicateOf_[i]] ;
+    if (!hasCharge(original.dPhi1(),original.dPhi2()) && hasCharge(duplicate.dPhi1(),duplicate.dPhi2()))
+     { original.setNegAttributes(duplicate.dRz2(),duplicate.dPhi2(),duplicate.dRz1(),duplicate.dPhi1()) ; }
+    if (!hasCharge(original.dPhi1Pos(),original.dPhi2Pos()) && hasCharge(duplicate.dPhi1Pos(),duplicate.dPhi2Pos()))
+     { original.setPosAttributes(duplicate.dRz2Pos(),duplicate.dPhi2Pos(),duplicate.dRz1Pos(),duplicate.dPhi1Pos()) ; }
+   }
+
+  unsigned kept = 0 ;
+  for ( unsigned i=0 ; i<nSeeds ; ++i )
+   {
+    if (duplicateOf_[i]>=0) continue ;
+    if (kept!=i) std::swap(seeds[kept],seeds[i]) ;
+    ++kept ;
+   }
+  seeds.erase(seeds.begin()+kept,seeds.end()) ;
+  LogDebug("ElectronSeedProducer")<<"Merged "<<nDuplicated<<" electron seeds with identical hits out of "<<nSeeds ;
  }
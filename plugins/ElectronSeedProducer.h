@@ -32,10 +32,14 @@ namespace edm
 
 #include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
+#include "DataFormats/EgammaReco/interface/ElectronSeedFwd.h"
 #include "DataFormats/TrajectorySeed/interface/TrajectorySeedCollection.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 #include "DataFormats/Common/interface/Handle.h"
 
+#include "ElectronSeedPhiIndex.h"
+#include "ElectronTrackerModuleTable.h"
+
 
 class ElectronSeedProducer : public edm::EDProducer
  {
@@ -44,31 +48,118 @@ class ElectronSeedProducer : public edm::EDProducer
     //static void fillDescriptions( edm::ConfigurationDescriptions & ) ;
 
     explicit ElectronSeedProducer( const edm::ParameterSet & ) ;
-    virtual void beginRun( edm::Run const&, edm::EventSetup const & ) override final;
-    virtual void endRun( edm::Run const&, edm::EventSetup const & ) override final;
     virtual ~ElectronSeedProducer() ;
 
+    virtual void endRun( edm::Run const&, edm::EventSetup const & ) override final;
     virtual void produce( edm::Event &, const edm::EventSetup & ) override final;
+    virtual void endJob() override ;
 
   private:
 
+    bool passEtCut( const reco::SuperCluster &, const reco::BeamSpot & ) const ;
+    bool inRegion( const reco::SuperCluster &, const reco::BeamSpot & ) const ;
+    void readRegions( edm::Event & ) ;
     void filterClusters
      ( const reco::BeamSpot & bs,
        const edm::Handle<reco::SuperClusterCollection> & superClusters,
+       const std::vector<bool> & selected,
        /*HBHERecHitMetaCollection*mhbhe,*/ reco::SuperClusterRefVector &sclRefs,
        std::vector<float> & hoe1s, std::vector<float> & hoe2s ) ;
     void filterSeeds(edm::Event& e, const edm::EventSetup& setup, reco::SuperClusterRefVector &sclRefs);
+    void checkSeedFilter( const edm::EventSetup & ) ;
+    void checkPhiRoadsSetup( const edm::EventSetup & ) ;
+    void putEmptyProducts( edm::Event & ) ;
+    void selectClusters
+     ( const edm::Handle<reco::SuperClusterCollection> * clusters, const reco::BeamSpot &,
+       bool prefilteredSeeds, unsigned nInitialSeeds ) ;
+    template <typename Seed, typename SameSeed>
+    unsigned findDuplicatedSeeds( const std::vector<Seed> &, SameSeed ) ;
+    void removeDuplicatedSeeds( TrajectorySeedCollection & ) ;
+    void mergeSeedsWithIdenticalHits( reco::ElectronSeedCollection & ) ;
+    float phiRoad( const reco::SuperCluster &, const reco::BeamSpot & ) const ;
+    void runInPhiRoads
+     ( edm::Event &, const edm::EventSetup &, const reco::BeamSpot &,
+       const TrajectorySeedCollection * eventSeeds, TrajectorySeedCollection * transientSeeds,
+       reco::ElectronSeedCollection & ) ;
 
     edm::InputTag superClusters_[2] ;
     edm::InputTag initialSeeds_ ;
     edm::InputTag beamSpotTag_ ;
+    edm::InputTag eventGuard_ ;
+
+    // regional mode : only the superclusters close to a trigger candidate
+    edm::InputTag regionalCandidates_ ;
+    double regionalCandidateMinEt_ ;
+    double regionalDeltaR_ ;
+    std::vector<std::pair<float,float> > regions_ ; // eta, phi
 
     edm::ParameterSet conf_ ;
     ElectronSeedGenerator * matcher_ ;
     SeedFilter * seedFilter_;
 
+    // the seed filter is rebuilt when one of the records its components
+    // depend on has changed, and also at each new run when
+    // rebuildSeedFilterEachRun is true (former behaviour)
+    unsigned long long trackerGeomCacheId_ ;
+    unsigned long long magFieldCacheId_ ;
+    unsigned long long trackerRecoGeomCacheId_ ;
+    unsigned long long transientRecHitCacheId_ ;
+    unsigned long long trackerTopoCacheId_ ;
+    bool rebuildSeedFilterEachRun_ ;
+
     TrajectorySeedCollection * theInitialSeedColl ;
 
+    // per-event scratch containers, cleared at the end of each event
+    // but kept alive so that their memory is reused
+    TrajectorySeedCollection prefilteredSeedColl_ ;
+    reco::SuperClusterRefVector clusterRefs_ ;
+    std::vector<float> hoe1s_, hoe2s_ ;
+
+    // prefiltered seeds : no region for the superclusters close to an
+    // already seeded one (lossy : the region of the seeded supercluster is
+    // built by SeedFilter from that supercluster only, and is not widened),
+    // and removal of the seeds produced several times
+    double skippedRegionsDeltaR_ ;
+    bool removeDuplicatedSeeds_ ;
+    std::vector<std::pair<float,float> > seededRegions_ ; // eta, phi
+    struct SeedKey
+     {
+      unsigned firstDetId ; unsigned nHits ; unsigned index ;
+      bool operator<( const SeedKey & other ) const
+       {
+        if (firstDetId!=other.firstDetId) return firstDetId<other.firstDetId ;
+        if (nHits!=other.nHits) return nHits<other.nHits ;
+        return index<other.index ;
+       }
+     } ;
+    std::vector<SeedKey> seedKeys_ ;
+    std::vector<int> duplicateOf_ ; // -1, or index of the first identical seed
+
+    // electron seeds of the same supercluster with identical hits : only
+    // the first one is kept, with the charge hypotheses of the others
+    bool mergeSeedsWithIdenticalHits_ ;
+
+    // initial seeds indexed in phi, so that each supercluster is only
+    // given the seeds whose first hit is in its phi road
+    bool initialSeedsPhiRoads_ ;
+    ElectronSeedPhiIndex initialSeedIndex_ ;
+    bool dynamicPhiRoad_ ;
+    double lowPtThreshold_, highPtThreshold_ ;
+    double deltaPhi1Low_, deltaPhi1High_, sizeWindowENeg_ ;
+    double maxPhi1_ ; // non dynamic road
+    double bFieldZ_ ;
+    ElectronTrackerModuleTable moduleTable_ ; // rebuilt when the tracker geometry changes
+    unsigned long long moduleTableCacheId_ ;
+    unsigned long long bFieldCacheId_ ;
+    std::vector<unsigned> roadWindow_ ;
+    std::vector<unsigned> roadKeysBegin_ ;
+    std::vector<unsigned> roadKeys_ ; // all the roads, one after the other
+    TrajectorySeedCollection roadSeedColl_ ;
+    TrajectorySeedCollection roadCopiedSeedColl_ ; // event seeds in at least one road
+    std::vector<int> roadCopyIndex_ ;
+    reco::SuperClusterRefVector roadClusterRefs_ ;
+    std::vector<float> roadHoe1s_, roadHoe2s_ ;
+
     // for the filter
 
     // H/E
@@ -100,6 +191,33 @@ class ElectronSeedProducer : public edm::EDProducer
     bool fromTrackerSeeds_;
     bool prefilteredSeeds_;
 
+    // adaptive mode : per event choice between the initial seeds and the
+    // prefiltered ones, from the number of superclusters passing the Et cut
+    // and the number of initial seeds ; the choice is put in the event
+    // (0 no seeding, 1 initial seeds, 2 prefiltered seeds)
+    bool adaptiveSeeding_ ;
+    unsigned adaptiveMaxSuperClusters_ ;
+    unsigned adaptiveMinInitialSeeds_ ;
+    unsigned long nStrategyEvents_[3] ;
+
+    // work budget : the superclusters passing the Et cut are taken by
+    // decreasing Et, up to maxSuperClusters, and as long as the seeds
+    // they would be matched with (the seeds of their phi road, or all the
+    // initial seeds) stay within maxSeedMatchingIterations ; the others
+    // are skipped, and the event is flagged as truncated
+    unsigned maxSuperClusters_ ;
+    unsigned maxSeedMatchingIterations_ ;
+    bool budgeted_ ;
+    bool truncated_ ;
+    struct BudgetCandidate
+     {
+      float et ; unsigned collection ; unsigned index ;
+      bool operator<( const BudgetCandidate & other ) const
+       { return et>other.et ; }
+     } ;
+    std::vector<BudgetCandidate> budgetCandidates_ ;
+    std::vector<bool> selectedClusters_[2] ; // empty when no budget
+
  } ;
 
 #endif
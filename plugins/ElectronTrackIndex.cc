@@ -0,0 +1,117 @@
+
+#include "ElectronTrackIndex.h"
+
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include <algorithm>
+#include <cmath>
+
+ElectronTrackIndex::ElectronTrackIndex( double ptMin, unsigned nPhiBins )
+ : ptMin_(ptMin), nPhiBins_(nPhiBins>0?nPhiBins:1),
+   phiBinWidth_(2.*M_PI/nPhiBins_), binBegin_(nPhiBins_+1,0)
+ {}
+
+void ElectronTrackIndex::clear()
+ {
+  entries_.clear() ;
+  eta_.clear() ; phi_.clear() ; key_.clear() ;
+  std::fill(binBegin_.begin(),binBegin_.end(),0) ;
+ }
+
+unsigned ElectronTrackIndex::phiBin( float phi ) const
+ {
+  int bin = static_cast<int>(std::floor((phi+M_PI)/phiBinWidth_)) ;
+  bin %= static_cast<int>(nPhiBins_) ;
+  if (bin<0) bin += nPhiBins_ ;
+  return bin ;
+ }
+
+void ElectronTrackIndex::build( const reco::TrackCollection & tracks )
+ {
+  clear() ;
+
+  unsigned key ;
+  reco::TrackCollection::const_iterator track ;
+  for ( track = tracks.begin(), key = 0 ; track != tracks.end() ; ++track, ++key )
+   {
+    if (track->pt()<ptMin_) continue ;
+    Entry entry ;
+    entry.eta = track->eta() ;
+    entry.phi = track->phi() ;
+    entry.key = key ;
+    entry.bin = phiBin(entry.phi) ;
+    entries_.push_back(entry) ;
+   }
+  std::sort(entries_.begin(),entries_.end()) ;
+
+  unsigned n = entries_.size() ;
+  eta_.resize(n) ; phi_.resize(n) ; key_.resize(n) ;
+  for ( unsigned i=0 ; i<n ; ++i )
+   {
+    const Entry & entry = entries_[i] ;
+    eta_[i] = entry.eta ; phi_[i] = entry.phi ; key_[i] = entry.key ;
+    ++binBegin_[entry.bin+1] ;
+   }
+  for ( unsigned bin=0 ; bin<nPhiBins_ ; ++bin )
+   { binBegin_[bin+1] += binBegin_[bin] ; }
+ }
+
+void ElectronTrackIndex::etaRange
+ ( unsigned bin, float etaMin, float etaMax, unsigned & begin, unsigned & end ) const
+ {
+  std::vector<float>::const_iterator first = eta_.begin()+binBegin_[bin] ;
+  std::vector<float>::const_iterator last = eta_.begin()+binBegin_[bin+1] ;
+  begin = std::lower_bound(first,last,etaMin)-eta_.begin() ;
+  end = std::upper_bound(first,last,etaMax)-eta_.begin() ;
+ }
+
+void ElectronTrackIndex::window
+ ( float eta, float phi, float dEta, float dPhi, std::vector<unsigned> & keys ) const
+ {
+  keys.clear() ;
+  if (key_.empty()) return ;
+
+  int firstBin = static_cast<int>(std::floor((phi-dPhi+M_PI)/phiBinWidth_)) ;
+  int lastBin = static_cast<int>(std::floor((phi+dPhi+M_PI)/phiBinWidth_)) ;
+  int nBins = std::min(lastBin-firstBin+1,static_cast<int>(nPhiBins_)) ;
+  for ( int ibin=0 ; ibin<nBins ; ++ibin )
+   {
+    int bin = (firstBin+ibin)%static_cast<int>(nPhiBins_) ;
+    if (bin<0) bin += nPhiBins_ ;
+    unsigned begin, end ;
+    etaRange(bin,eta-dEta,eta+dEta,begin,end) ;
+    for ( unsigned i=begin ; i<end ; ++i )
+     {
+      float dphi = phi_[i]-phi ;
+      if (dphi>M_PI) dphi -= 2.*M_PI ;
+      else if (dphi<-M_PI) dphi += 2.*M_PI ;
+      if (std::abs(dphi)<=dPhi) keys.push_back(key_[i]) ;
+     }
+   }
+  std::sort(keys.begin(),keys.end()) ;
+ }
+
+unsigned ElectronTrackIndex::count( float eta, float phi, float dEta, float dPhi ) const
+ {
+  unsigned counter = 0 ;
+  if (key_.empty()) return counter ;
+
+  int firstBin = static_cast<int>(std::floor((phi-dPhi+M_PI)/phiBinWidth_)) ;
+  int lastBin = static_cast<int>(std::floor((phi+dPhi+M_PI)/phiBinWidth_)) ;
+  int nBins = std::min(lastBin-firstBin+1,static_cast<int>(nPhiBins_)) ;
+  for ( int ibin=0 ; ibin<nBins ; ++ibin )
+   {
+    int bin = (firstBin+ibin)%static_cast<int>(nPhiBins_) ;
+    if (bin<0) bin += nPhiBins_ ;
+    unsigned begin, end ;
+    etaRange(bin,eta-dEta,eta+dEta,begin,end) ;
+    for ( unsigned i=begin ; i<end ; ++i )
+     {
+      float dphi = phi_[i]-phi ;
+      if (dphi>M_PI) dphi -= 2.*M_PI ;
+      else if (dphi<-M_PI) dphi += 2.*M_PI ;
+      if (std::abs(dphi)<=dPhi) ++counter ;
+     }
+   }
+  return counter ;
+ }
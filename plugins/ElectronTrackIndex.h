@@ -0,0 +1,60 @@
+
+#ifndef ElectronTrackIndex_h
+#define ElectronTrackIndex_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           ElectronTrackIndex
+//
+// Description:     Per-event structure-of-arrays copy of a track collection,
+//                  bucketed in phi and sorted in eta within each bucket,
+//                  so that cone searches only visit the tracks of the
+//                  requested eta-phi window.
+
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+
+#include <vector>
+
+class ElectronTrackIndex
+ {
+  public:
+
+    explicit ElectronTrackIndex( double ptMin =0., unsigned nPhiBins =32 ) ;
+
+    // to be called once per event
+    void build( const reco::TrackCollection & ) ;
+    void clear() ;
+    unsigned size() const { return key_.size() ; }
+
+    // fills keys with the position, in the original collection, of the tracks
+    // such as |deta|<=dEta and |dphi|<=dPhi, sorted in increasing order
+    void window( float eta, float phi, float dEta, float dPhi, std::vector<unsigned> & keys ) const ;
+
+    // number of tracks that window() would give, without filling any vector
+    unsigned count( float eta, float phi, float dEta, float dPhi ) const ;
+
+  private:
+
+    struct Entry
+     {
+      unsigned bin ; float eta, phi ; unsigned key ;
+      bool operator<( const Entry & other ) const
+       { return (bin<other.bin)||((bin==other.bin)&&(eta<other.eta)) ; }
+     } ;
+
+    unsigned phiBin( float phi ) const ;
+    void etaRange( unsigned bin, float etaMin, float etaMax, unsigned & begin, unsigned & end ) const ;
+
+    double ptMin_ ;
+    unsigned nPhiBins_ ;
+    float phiBinWidth_ ;
+
+    std::vector<Entry> entries_ ; // scratch for sorting
+
+    std::vector<float> eta_ ;
+    std::vector<float> phi_ ;
+    std::vector<unsigned> key_ ;
+    std::vector<unsigned> binBegin_ ; // nPhiBins_+1 offsets in the arrays above
+ } ;
+
+#endif
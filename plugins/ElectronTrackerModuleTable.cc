@@ -0,0 +1,49 @@
+
+#include "ElectronTrackerModuleTable.h"
+
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "Geometry/CommonDetUnit/interface/GeomDet.h"
+
+#include <algorithm>
+#include <utility>
+
+void ElectronTrackerModuleTable::clear()
+ {
+  detId_.clear() ;
+  placement_.clear() ;
+ }
+
+void ElectronTrackerModuleTable::build( const TrackerGeometry & tracker )
+ {
+  clear() ;
+
+  std::vector<std::pair<uint32_t,const GeomDet *> > dets ;
+  TrackerGeometry::DetContainer::const_iterator det ;
+  for ( det = tracker.dets().begin() ; det != tracker.dets().end() ; ++det )
+   { dets.push_back(std::make_pair((*det)->geographicalId().rawId(),*det)) ; }
+  std::sort(dets.begin(),dets.end()) ;
+
+  unsigned n = dets.size() ;
+  detId_.resize(n) ;
+  placement_.resize(n*nPlacement) ;
+  for ( unsigned i=0 ; i<n ; ++i )
+   {
+    detId_[i] = dets[i].first ;
+    const Surface & surface = dets[i].second->surface() ;
+    const Surface::RotationType & rotation = surface.rotation() ;
+    float * p = &placement_[i*nPlacement] ;
+    p[0] = surface.position().x() ;
+    p[1] = surface.position().y() ;
+    p[2] = surface.position().z() ;
+    p[3] = rotation.xx() ; p[4] = rotation.xy() ; p[5] = rotation.xz() ;
+    p[6] = rotation.yx() ; p[7] = rotation.yy() ; p[8] = rotation.yz() ;
+   }
+ }
+
+int ElectronTrackerModuleTable::index( uint32_t detId ) const
+ {
+  std::vector<uint32_t>::const_iterator found
+   = std::lower_bound(detId_.begin(),detId_.end(),detId) ;
+  if ((found==detId_.end())||(*found!=detId)) return -1 ;
+  return found-detId_.begin() ;
+ }
@@ -0,0 +1,53 @@
+
+#ifndef ElectronTrackerModuleTable_h
+#define ElectronTrackerModuleTable_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           ElectronTrackerModuleTable
+//
+// Description:     Flat copy of the tracker module placements, indexed by
+//                  the position of the DetId in a sorted table, so that the
+//                  local to global transform of the hits is plain arithmetic
+//                  instead of virtual calls on the GeomDet surfaces. Meant
+//                  to be rebuilt only when the tracker geometry changes.
+
+#include <vector>
+#include <stdint.h>
+
+class TrackerGeometry ;
+
+class ElectronTrackerModuleTable
+ {
+  public:
+
+    ElectronTrackerModuleTable() {}
+
+    void build( const TrackerGeometry & ) ;
+    void clear() ;
+    unsigned size() const { return detId_.size() ; }
+
+    // index of the module with the given raw id, or -1 if unknown
+    int index( uint32_t detId ) const ;
+
+    // global position of a point of the module plane (local z=0)
+    void toGlobal
+     ( unsigned index, float localX, float localY,
+       float & x, float & y, float & z ) const
+     {
+      const float * p = &placement_[index*nPlacement] ;
+      x = p[0]+localX*p[3]+localY*p[6] ;
+      y = p[1]+localX*p[4]+localY*p[7] ;
+      z = p[2]+localX*p[5]+localY*p[8] ;
+     }
+
+  private:
+
+    // position of the module, then its local x and y axes in global frame
+    static const unsigned nPlacement = 9 ;
+
+    std::vector<uint32_t> detId_ ; // sorted
+    std::vector<float> placement_ ; // nPlacement per module
+ } ;
+
+#endif
@@ -37,22 +37,39 @@ GEDGsfElectronCoreProducer::GEDGsfElectronCoreProducer( const edm::ParameterSet
 
 void GEDGsfElectronCoreProducer::produce( edm::Event & event, const edm::EventSetup & setup )
  {
+  if (skipEvent(event)) return ;
+
   // base input
   GsfElectronCoreBaseProducer::initEvent(event,setup) ;
 
   event.getByLabel(gedEMUnbiasedTag_,gedEMUnbiasedH_);
 
-  // output
-  std::auto_ptr<GsfElectronCoreCollection> electrons(new GsfElectronCoreCollection) ;
+  // transient cores, in the arena
+  ElectronCoreVector eleCores((ElectronArenaAllocator<GsfElectronCore *>(arena_))) ;
 
   const PFCandidateCollection * pfCandidateCollection = gedEMUnbiasedH_.product();
   for ( unsigned int i=0 ; i<pfCandidateCollection->size() ; ++i )
-           produceElectronCore((*pfCandidateCollection)[i],electrons.get()) ;
+           produceElectronCore((*pfCandidateCollection)[i],eleCores) ;
+
+  // ctf association, for all the cores at once
+  GsfElectronCoreBaseProducer::fillElectronCores(eleCores) ;
+
+  // output
+  std::auto_ptr<GsfElectronCoreCollection> electrons(new GsfElectronCoreCollection) ;
+  electrons->reserve(eleCores.size()) ;
+  ElectronCoreVector::iterator eleCore ;
+  for ( eleCore = eleCores.begin() ; eleCore != eleCores.end() ; ++eleCore )
+   {
+    electrons->push_back(**eleCore) ;
+    deleteElectronCore(*eleCore) ;
+   }
+  eleCores.clear() ;
     
   event.put(electrons) ;
+  GsfElectronCoreBaseProducer::endEvent(event) ;
  }
 
-void GEDGsfElectronCoreProducer::produceElectronCore( const reco::PFCandidate & pfCandidate, reco::GsfElectronCoreCollection * electrons )
+void GEDGsfElectronCoreProducer::produceElectronCore( const reco::PFCandidate & pfCandidate, ElectronCoreVector & eleCores )
  {
   const GsfTrackRef gsfTrackRef = pfCandidate.gsfTrackRef();
   if(gsfTrackRef.isNull()) 
@@ -62,9 +79,7 @@ void GEDGsfElectronCoreProducer::produceElectronCore( const reco::PFCandidate &
   if(extraRef.isNull()) 
 	return;
 
-  GsfElectronCore * eleCore = new GsfElectronCore(gsfTrackRef) ;
-
-  GsfElectronCoreBaseProducer::fillElectronCore(eleCore) ;
+  GsfElectronCore * eleCore = newElectronCore(gsfTrackRef) ;
 
   SuperClusterRef scRef = extraRef->superClusterRef();
   SuperClusterRef scBoxRef = extraRef->superClusterBoxRef();  
@@ -73,12 +88,13 @@ void GEDGsfElectronCoreProducer::produceElectronCore( const reco::PFCandidate &
   {
        eleCore->setSuperCluster(scRef) ;
        eleCore->setPflowSuperCluster(scBoxRef) ;
-       electrons->push_back(*eleCore) ;
+       eleCores.push_back(eleCore) ;
    }
    else
-   { edm::LogWarning("GEDGsfElectronCoreProducer")<<"Both superClusterRef and superClusterBoxRef of pfCandidate.egammaExtraRef() are Null" ; }
-  
-  delete eleCore ;
+   {
+    edm::LogWarning("GEDGsfElectronCoreProducer")<<"Both superClusterRef and superClusterBoxRef of pfCandidate.egammaExtraRef() are Null" ;
+    deleteElectronCore(eleCore) ;
+   }
  }
 
 GEDGsfElectronCoreProducer::~GEDGsfElectronCoreProducer()
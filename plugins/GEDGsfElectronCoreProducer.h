@@ -17,7 +17,7 @@ class GEDGsfElectronCoreProducer : public GsfElectronCoreBaseProducer
 
   private:
 
-    void produceElectronCore( const reco::PFCandidate & pfCandidate, reco::GsfElectronCoreCollection * electrons ) ;
+    void produceElectronCore( const reco::PFCandidate & pfCandidate, ElectronCoreVector & eleCores ) ;
 
     edm::Handle<reco::PFCandidateCollection> gedEMUnbiasedH_;
 
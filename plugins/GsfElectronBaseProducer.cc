@@ -22,6 +22,8 @@
 #include "DataFormats/EcalRecHit/interface/EcalSeverityLevel.h"
 
 
+#include "ElectronEventGuard.h"
+
 #include <iostream>
 
 using namespace reco;
@@ -145,6 +147,9 @@ void GsfElectronBaseProducer::fillDescription( edm::ParameterSetDescription & de
   // Corrections
   desc.add<std::string>("superClusterErrorFunction","EcalClusterEnergyUncertaintyObjectSpecific") ;
   desc.add<std::string>("crackCorrectionFunction","EcalClusterCrackCorrection") ;
+
+  // optional guard
+  desc.add<edm::InputTag>("eventGuard",edm::InputTag()) ;
  }
 
 GsfElectronBaseProducer::GsfElectronBaseProducer( const edm::ParameterSet& cfg )
@@ -152,6 +157,9 @@ GsfElectronBaseProducer::GsfElectronBaseProducer( const edm::ParameterSet& cfg )
  {
   produces<GsfElectronCollection>();
 
+  if (cfg.exists("eventGuard"))
+   { eventGuard_ = cfg.getParameter<edm::InputTag>("eventGuard") ; }
+
   inputCfg_.previousGsfElectrons = cfg.getParameter<edm::InputTag>("previousGsfElectronsTag");
   inputCfg_.pflowGsfElectronsTag = cfg.getParameter<edm::InputTag>("pflowGsfElectronsTag");
   inputCfg_.gsfElectronCores = cfg.getParameter<edm::InputTag>("gsfElectronCoresTag");
@@ -396,6 +404,13 @@ void GsfElectronBaseProducer::endEvent()
   algo_->endEvent() ;
  }
 
+bool GsfElectronBaseProducer::skipEvent( edm::Event & event )
+ {
+  if (ElectronEventGuard::passed(event,eventGuard_)) return false ;
+  event.put(std::auto_ptr<GsfElectronCollection>(new GsfElectronCollection)) ;
+  return true ;
+ }
+
 void GsfElectronBaseProducer::checkEcalSeedingParameters( edm::ParameterSetID const & psetid )
  {
   edm::ParameterSet pset ;
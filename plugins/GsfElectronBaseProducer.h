@@ -39,6 +39,9 @@ class GsfElectronBaseProducer : public edm::EDProducer
     void beginEvent( edm::Event &, const edm::EventSetup & ) ;
     void fillEvent( edm::Event & ) ;
     void endEvent() ;
+    // puts an empty collection and returns true when the event guard,
+    // if any, rejected the event
+    bool skipEvent( edm::Event & ) ;
     reco::GsfElectron * newElectron() { return 0 ; }
 
     // configurables
@@ -53,6 +56,7 @@ class GsfElectronBaseProducer : public edm::EDProducer
 
     // check expected configuration of previous modules
     bool ecalSeedingParametersChecked_ ;
+    edm::InputTag eventGuard_ ;
     void checkEcalSeedingParameters( edm::ParameterSetID const & ) ;
 
  } ;
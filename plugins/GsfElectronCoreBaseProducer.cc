@@ -1,6 +1,7 @@
 
 #include "GsfElectronCoreBaseProducer.h"
 
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -11,6 +12,12 @@
 #include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
 #include "DataFormats/EgammaReco/interface/ElectronSeedFwd.h"
 #include "DataFormats/EgammaReco/interface/ElectronSeed.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include "ElectronEventGuard.h"
+
+#include <algorithm>
+
 //#include "DataFormats/Common/interface/ValueMap.h"
 
 //#include <map>
@@ -23,20 +30,42 @@ void GsfElectronCoreBaseProducer::fillDescription( edm::ParameterSetDescription
   desc.add<edm::InputTag>("gsfTracks",edm::InputTag("electronGsfTracks")) ;
   desc.add<edm::InputTag>("ctfTracks",edm::InputTag("generalTracks")) ;
   desc.add<bool>("useGsfPfRecTracks",true) ;
+  desc.add<edm::InputTag>("eventGuard",edm::InputTag()) ;
+  desc.add<unsigned>("maxElectronCores",0) ;
+  desc.add<unsigned>("maxCtfAssociationIterations",0) ;
  }
 
 GsfElectronCoreBaseProducer::GsfElectronCoreBaseProducer( const edm::ParameterSet & config )
+ : maxElectronCores_(0), maxCtfAssociationIterations_(0), truncated_(false),
+   ctfTrackIndex_(0.)
  {
   produces<GsfElectronCoreCollection>() ;
   gsfPfRecTracksTag_ = config.getParameter<edm::InputTag>("gsfPfRecTracks") ;
   gsfTracksTag_ = config.getParameter<edm::InputTag>("gsfTracks") ;
   ctfTracksTag_ = config.getParameter<edm::InputTag>("ctfTracks") ;
   useGsfPfRecTracks_ = config.getParameter<bool>("useGsfPfRecTracks") ;
+  if (config.exists("eventGuard"))
+   { eventGuard_ = config.getParameter<edm::InputTag>("eventGuard") ; }
+  if (config.exists("maxElectronCores"))
+   { maxElectronCores_ = config.getParameter<unsigned>("maxElectronCores") ; }
+  if (config.exists("maxCtfAssociationIterations"))
+   { maxCtfAssociationIterations_ = config.getParameter<unsigned>("maxCtfAssociationIterations") ; }
+  if (maxElectronCores_||maxCtfAssociationIterations_)
+   { produces<bool>("truncated") ; }
  }
 
 GsfElectronCoreBaseProducer::~GsfElectronCoreBaseProducer()
  {}
 
+void GsfElectronCoreBaseProducer::endJob()
+ {
+  edm::LogInfo("GsfElectronCoreBaseProducer|Arena")
+    <<"scratch arena: high water mark "<<arena_.highWaterMark()<<" bytes"
+    <<", capacity "<<arena_.capacity()<<" bytes"
+    <<", "<<arena_.nBlockAllocations()<<" block allocations"
+    <<" for "<<arena_.nResets()<<" events" ;
+ }
+
 
 //=======================================================================================
 // For derived producers
@@ -49,9 +78,112 @@ void GsfElectronCoreBaseProducer::initEvent( edm::Event & event, const edm::Even
    { event.getByLabel(gsfPfRecTracksTag_,gsfPfRecTracksH_) ; }
   event.getByLabel(gsfTracksTag_,gsfTracksH_) ;
   event.getByLabel(ctfTracksTag_,ctfTracksH_) ;
+  ctfTrackIndex_.build(*ctfTracksH_) ;
+  truncated_ = false ;
+ }
+
+// to be called at the end of each event
+void GsfElectronCoreBaseProducer::endEvent( edm::Event & event )
+ {
+  if (maxElectronCores_||maxCtfAssociationIterations_)
+   { event.put(std::auto_ptr<bool>(new bool(truncated_)),"truncated") ; }
+  arena_.reset() ;
  }
 
-void GsfElectronCoreBaseProducer::fillElectronCore( reco::GsfElectronCore * eleCore )
+// to be called first, the event being skipped when it returns true
+bool GsfElectronCoreBaseProducer::skipEvent( edm::Event & event )
+ {
+  if (ElectronEventGuard::passed(event,eventGuard_)) return false ;
+  event.put(std::auto_ptr<GsfElectronCoreCollection>(new GsfElectronCoreCollection)) ;
+  truncated_ = false ;
+  endEvent(event) ;
+  return true ;
+ }
+
+GsfElectronCore * GsfElectronCoreBaseProducer::newElectronCore( const GsfTrackRef & gsfTrackRef )
+ {
+  void * place = arena_.allocate(sizeof(GsfElectronCore),alignof(GsfElectronCore)) ;
+  return new (place) GsfElectronCore(gsfTrackRef) ;
+ }
+
+GsfElectronCore * GsfElectronCoreBaseProducer::newElectronCore( const GsfElectronCore & other )
+ {
+  void * place = arena_.allocate(sizeof(GsfElectronCore),alignof(GsfElectronCore)) ;
+  return new (place) GsfElectronCore(other) ;
+ }
+
+// the memory itself is released by the reset of the arena
+void GsfElectronCoreBaseProducer::deleteElectronCore( GsfElectronCore * eleCore )
+ { eleCore->~GsfElectronCore() ; }
+
+void GsfElectronCoreBaseProducer::fillElectronCores( ElectronCoreVector & eleCores )
+ { fillElectronCores(eleCores,eleCores.size()) ; }
+
+void GsfElectronCoreBaseProducer::fillElectronCores( ElectronCoreVector & eleCores, std::size_t firstAssociated )
+ {
+  associateCores_.assign(eleCores.size(),0) ;
+  std::fill(associateCores_.begin(),associateCores_.begin()+firstAssociated,1) ;
+  applyBudget(eleCores) ;
+  for ( std::size_t i=0 ; i<eleCores.size() ; ++i )
+   { if (associateCores_[i]) fillElectronCore(eleCores[i]) ; }
+  associateCores_.clear() ;
+ }
+
+// the selection is done by decreasing pt, but the cores keep their order ;
+// a kept core always gets its ctf association
+void GsfElectronCoreBaseProducer::applyBudget( ElectronCoreVector & eleCores )
+ {
+  if (!maxElectronCores_&&!maxCtfAssociationIterations_) return ;
+
+  unsigned nCores = eleCores.size() ;
+  budgetOrder_.clear() ;
+  for ( unsigned i=0 ; i<nCores ; ++i )
+   { budgetOrder_.push_back(std::make_pair(-eleCores[i]->gsfTrack()->pt(),i)) ; }
+  std::sort(budgetOrder_.begin(),budgetOrder_.end()) ;
+
+  // same window as in getCtfTrackRef
+  const float window = 0.3+0.001 ;
+  keepCores_.assign(nCores,1) ;
+  unsigned nKept = 0, iterations = 0 ;
+  bool exhausted = false ;
+  std::vector<std::pair<float,unsigned> >::const_iterator ordered ;
+  for ( ordered = budgetOrder_.begin() ; ordered != budgetOrder_.end() ; ++ordered )
+   {
+    unsigned i = ordered->second ;
+    if (exhausted||(maxElectronCores_&&(nKept>=maxElectronCores_)))
+     { keepCores_[i] = 0 ; truncated_ = true ; continue ; }
+    if (maxCtfAssociationIterations_&&associateCores_[i])
+     {
+      const GsfTrackRef & gsfTrackRef = eleCores[i]->gsfTrack() ;
+      unsigned cost = ctfTrackIndex_.count(gsfTrackRef->eta(),gsfTrackRef->phi(),window,window) ;
+      if (iterations+cost>maxCtfAssociationIterations_)
+       { exhausted = true ; keepCores_[i] = 0 ; truncated_ = true ; continue ; }
+      iterations += cost ;
+     }
+    ++nKept ;
+   }
+
+  if (nKept<nCores)
+   {
+    unsigned kept = 0 ;
+    for ( unsigned i=0 ; i<nCores ; ++i )
+     {
+      if (!keepCores_[i]) { deleteElectronCore(eleCores[i]) ; continue ; }
+      eleCores[kept] = eleCores[i] ;
+      associateCores_[kept] = associateCores_[i] ;
+      ++kept ;
+     }
+    eleCores.resize(kept) ;
+    associateCores_.resize(kept) ;
+   }
+  if (truncated_)
+   {
+    edm::LogWarning("GsfElectronCoreBaseProducer|Budget")
+      <<"work budget exceeded: "<<(nCores-nKept)<<" cores dropped out of "<<nCores ;
+   }
+ }
+
+void GsfElectronCoreBaseProducer::fillElectronCore( reco::GsfElectronCore * eleCore ) const
  {
   const GsfTrackRef & gsfTrackRef = eleCore->gsfTrack() ;
 
@@ -65,7 +197,7 @@ void GsfElectronCoreBaseProducer::fillElectronCore( reco::GsfElectronCore * eleC
 //=======================================================================================
 
 std::pair<TrackRef,float> GsfElectronCoreBaseProducer::getCtfTrackRef
- ( const GsfTrackRef & gsfTrackRef )
+ ( const GsfTrackRef & gsfTrackRef ) const
  {
   float maxFracShared = 0;
   TrackRef ctfTrackRef = TrackRef() ;
@@ -74,11 +206,19 @@ std::pair<TrackRef,float> GsfElectronCoreBaseProducer::getCtfTrackRef
   // get the Hit Pattern for the gsfTrack
   const HitPattern& gsfHitPattern = gsfTrackRef->hitPattern();
 
+  // only look at the tracks in the eta-phi window of the gsf track,
+  // in the order of the collection
+  const double maxDr = 0.3 ;
+  std::vector<unsigned> ctfKeys ;
+  ctfTrackIndex_.window(gsfTrackRef->eta(),gsfTrackRef->phi(),maxDr+0.001,maxDr+0.001,ctfKeys) ;
+
   unsigned int counter ;
   TrackCollection::const_iterator ctfTkIter ;
-  for ( ctfTkIter = ctfTrackCollection->begin() , counter = 0 ;
-        ctfTkIter != ctfTrackCollection->end() ; ctfTkIter++, counter++ )
+  std::vector<unsigned>::const_iterator ctfKey ;
+  for ( ctfKey = ctfKeys.begin() ; ctfKey != ctfKeys.end() ; ++ctfKey )
    {
+    counter = *ctfKey ;
+    ctfTkIter = ctfTrackCollection->begin()+counter ;
 
     double dEta = gsfTrackRef->eta() - ctfTkIter->eta();
     double dPhi = gsfTrackRef->phi() - ctfTkIter->phi();
@@ -86,7 +226,7 @@ std::pair<TrackRef,float> GsfElectronCoreBaseProducer::getCtfTrackRef
     if(std::abs(dPhi) > pi) dPhi = 2*pi - std::abs(dPhi);
 
     // dont want to look at every single track in the event!
-    if(sqrt(dEta*dEta + dPhi*dPhi) > 0.3) continue;
+    if(sqrt(dEta*dEta + dPhi*dPhi) > maxDr) continue;
 
     unsigned int shared = 0 ;
     int gsfHitCounter = 0 ;
@@ -28,6 +28,11 @@ namespace edm
 #include "DataFormats/GsfTrackReco/interface/GsfTrackFwd.h"
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
 
+#include <vector>
+
+#include "ElectronTrackIndex.h"
+#include "ElectronEventArena.h"
+
 class GsfElectronCoreBaseProducer : public edm::EDProducer
  {
   public:
@@ -36,29 +41,66 @@ class GsfElectronCoreBaseProducer : public edm::EDProducer
 
     explicit GsfElectronCoreBaseProducer( const edm::ParameterSet & conf ) ;
     virtual ~GsfElectronCoreBaseProducer() ;
+    virtual void endJob() ;
 
 
   protected:
 
     // to be called by derived producers at the beginning of each new event
     void initEvent( edm::Event & event, const edm::EventSetup & setup ) ;
+    // to be called by derived producers at the end of each event,
+    // once the cores are put and the scratch cores deleted
+    void endEvent( edm::Event & event ) ;
+    // puts an empty collection and returns true when the event guard,
+    // if any, rejected the event
+    bool skipEvent( edm::Event & event ) ;
     edm::Handle<reco::GsfPFRecTrackCollection> gsfPfRecTracksH_ ;
     edm::Handle<reco::GsfTrackCollection> gsfTracksH_ ;
     edm::Handle<reco::TrackCollection> ctfTracksH_ ;
     bool useGsfPfRecTracks_ ;
 
-    void fillElectronCore( reco::GsfElectronCore * ) ;
+    // transient cores, allocated in the per-event arena
+    typedef std::vector<reco::GsfElectronCore *,ElectronArenaAllocator<reco::GsfElectronCore *> > ElectronCoreVector ;
+    ElectronEventArena arena_ ;
+    reco::GsfElectronCore * newElectronCore( const reco::GsfTrackRef & ) ;
+    reco::GsfElectronCore * newElectronCore( const reco::GsfElectronCore & ) ;
+    void deleteElectronCore( reco::GsfElectronCore * ) ;
+
+    // set the ctf track of the cores, within the work budget if any ;
+    // the cores from firstAssociated on already have their ctf track,
+    // and only count in maxElectronCores
+    void fillElectronCores( ElectronCoreVector & ) ;
+    void fillElectronCores( ElectronCoreVector &, std::size_t firstAssociated ) ;
 
   private:
 
     edm::InputTag gsfPfRecTracksTag_ ;
     edm::InputTag gsfTracksTag_ ;
     edm::InputTag ctfTracksTag_ ;
+    edm::InputTag eventGuard_ ;
+
+    void fillElectronCore( reco::GsfElectronCore * ) const ;
+
+    // work budget : the cores are taken by decreasing gsf track pt, and
+    // dropped beyond maxElectronCores, or from the first one which would go
+    // beyond maxCtfAssociationIterations (number of ctf tracks in the
+    // association windows) ; the truncation is put in the event, when a
+    // budget is given
+    void applyBudget( ElectronCoreVector & ) ;
+    unsigned maxElectronCores_ ;
+    unsigned maxCtfAssociationIterations_ ;
+    bool truncated_ ;
+    std::vector<std::pair<float,unsigned> > budgetOrder_ ; // -pt, index
+    std::vector<char> keepCores_ ;
+    std::vector<char> associateCores_ ;
+
+    // ctf tracks sorted in eta and bucketed in phi, rebuilt for each event
+    ElectronTrackIndex ctfTrackIndex_ ;
 
     // From Puneeth Kalavase : returns the CTF track that has the highest fraction
     // of shared hits in Pixels and the inner strip tracker with the electron Track
     std::pair<reco::TrackRef,float> getCtfTrackRef
-     ( const reco::GsfTrackRef & ) ;
+     ( const reco::GsfTrackRef & ) const ;
 
  } ;
 
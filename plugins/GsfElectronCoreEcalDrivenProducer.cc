@@ -30,11 +30,13 @@ GsfElectronCoreEcalDrivenProducer::GsfElectronCoreEcalDrivenProducer( const edm:
 
 void GsfElectronCoreEcalDrivenProducer::produce( edm::Event & event, const edm::EventSetup & setup )
  {
+  if (skipEvent(event)) return ;
+
   // base input
   GsfElectronCoreBaseProducer::initEvent(event,setup) ;
 
-  // output
-  std::auto_ptr<GsfElectronCoreCollection> electrons(new GsfElectronCoreCollection) ;
+  // transient cores, in the arena
+  ElectronCoreVector eleCores((ElectronArenaAllocator<GsfElectronCore *>(arena_))) ;
 
   // loop on ecal driven tracks
   if (useGsfPfRecTracks_)
@@ -46,7 +48,7 @@ void GsfElectronCoreEcalDrivenProducer::produce( edm::Event & event, const edm::
           ++gsfPfRecTrack )
      {
       const GsfTrackRef gsfTrackRef = gsfPfRecTrack->gsfTrackRef() ;
-      produceEcalDrivenCore(gsfTrackRef,electrons.get()) ;
+      produceEcalDrivenCore(gsfTrackRef,eleCores) ;
      }
    }
   else
@@ -55,21 +57,34 @@ void GsfElectronCoreEcalDrivenProducer::produce( edm::Event & event, const edm::
     for ( unsigned int i=0 ; i<gsfTrackCollection->size() ; ++i )
      {
       const GsfTrackRef gsfTrackRef = edm::Ref<GsfTrackCollection>(gsfTracksH_,i) ;
-      produceEcalDrivenCore(gsfTrackRef,electrons.get()) ;
+      produceEcalDrivenCore(gsfTrackRef,eleCores) ;
      }
    }
 
+  // ctf association, for all the cores at once
+  GsfElectronCoreBaseProducer::fillElectronCores(eleCores) ;
+
+  // output
+  std::auto_ptr<GsfElectronCoreCollection> electrons(new GsfElectronCoreCollection) ;
+  electrons->reserve(eleCores.size()) ;
+  ElectronCoreVector::iterator eleCore ;
+  for ( eleCore = eleCores.begin() ; eleCore != eleCores.end() ; ++eleCore )
+   {
+    electrons->push_back(**eleCore) ;
+    deleteElectronCore(*eleCore) ;
+   }
+  eleCores.clear() ;
+
   event.put(electrons) ;
+  GsfElectronCoreBaseProducer::endEvent(event) ;
  }
 
-void GsfElectronCoreEcalDrivenProducer::produceEcalDrivenCore( const GsfTrackRef & gsfTrackRef, GsfElectronCoreCollection * electrons )
+void GsfElectronCoreEcalDrivenProducer::produceEcalDrivenCore( const GsfTrackRef & gsfTrackRef, ElectronCoreVector & eleCores )
  {
-  GsfElectronCore * eleCore = new GsfElectronCore(gsfTrackRef) ;
+  GsfElectronCore * eleCore = newElectronCore(gsfTrackRef) ;
 
   if (!eleCore->ecalDrivenSeed())
-   { delete eleCore ; return ; }
-
-  GsfElectronCoreBaseProducer::fillElectronCore(eleCore) ;
+   { deleteElectronCore(eleCore) ; return ; }
 
   edm::RefToBase<TrajectorySeed> seed = gsfTrackRef->extra()->seedRef() ;
   ElectronSeedRef elseed = seed.castTo<ElectronSeedRef>() ;
@@ -78,12 +93,13 @@ void GsfElectronCoreEcalDrivenProducer::produceEcalDrivenCore( const GsfTrackRef
   if (!scRef.isNull())
    {
     eleCore->setSuperCluster(scRef) ;
-    electrons->push_back(*eleCore) ;
+    eleCores.push_back(eleCore) ;
    }
   else
-   { edm::LogWarning("GsfElectronCoreEcalDrivenProducer")<<"Seed CaloCluster is not a SuperCluster, unexpected..." ; }
-
-  delete eleCore ;
+   {
+    edm::LogWarning("GsfElectronCoreEcalDrivenProducer")<<"Seed CaloCluster is not a SuperCluster, unexpected..." ;
+    deleteElectronCore(eleCore) ;
+   }
  }
 
 GsfElectronCoreEcalDrivenProducer::~GsfElectronCoreEcalDrivenProducer()
@@ -16,7 +16,7 @@ class GsfElectronCoreEcalDrivenProducer : public GsfElectronCoreBaseProducer
 
   private:
 
-    void produceEcalDrivenCore( const reco::GsfTrackRef & gsfTrackRef, reco::GsfElectronCoreCollection * electrons ) ;
+    void produceEcalDrivenCore( const reco::GsfTrackRef & gsfTrackRef, ElectronCoreVector & eleCores ) ;
 
  } ;
 
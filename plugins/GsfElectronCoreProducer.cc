@@ -15,6 +15,7 @@
 #include "DataFormats/Common/interface/ValueMap.h"
 
 #include <map>
+#include <algorithm>
 
 using namespace reco ;
 
@@ -40,15 +41,18 @@ GsfElectronCoreProducer::GsfElectronCoreProducer( const edm::ParameterSet & conf
 
 void GsfElectronCoreProducer::produce( edm::Event & event, const edm::EventSetup & setup )
  {
+  if (skipEvent(event)) return ;
+
   // base input
   GsfElectronCoreBaseProducer::initEvent(event,setup) ;
 
-  // transient output
-  std::list<GsfElectronCore *> electrons ;
+  // transient output, in the arena
+  ElectronCoreVector electrons((ElectronArenaAllocator<GsfElectronCore *>(arena_))) ;
 
   // event input
   event.getByLabel(edCoresTag_,edCoresH_) ;
   event.getByLabel(pfCoresTag_,pfCoresH_) ;
+  electrons.reserve(gsfTracksH_->size()+edCoresH_->size()) ;
 //  event.getByLabel(pfSuperClustersTag_,pfClustersH_) ;
 //  event.getByLabel(pfSuperClusterTrackMapTag_,pfClusterTracksH_) ;
 
@@ -76,62 +80,89 @@ void GsfElectronCoreProducer::produce( edm::Event & event, const edm::EventSetup
    }
 
   // clone ecal driven electrons
+  std::size_t nTrackerDriven = electrons.size() ;
   const GsfElectronCoreCollection * edCoresCollection = edCoresH_.product() ;
   GsfElectronCoreCollection::const_iterator edCoreIter ;
   for
    ( edCoreIter = edCoresCollection->begin() ;
      edCoreIter != edCoresCollection->end() ;
      edCoreIter++ )
-   { electrons.push_back(edCoreIter->clone()) ; }
+   { electrons.push_back(newElectronCore(*edCoreIter)) ; }
+
+  // ctf association of the tracker driven cores, the clones being already
+  // associated, but counted in the work budget
+  GsfElectronCoreBaseProducer::fillElectronCores(electrons,nTrackerDriven) ;
+
+  // hot fields of the transient cores, in structure-of-arrays form
+  unsigned nElectrons = electrons.size() ;
+  gsfTrackIds_.resize(nElectrons) ;
+  gsfTrackKeys_.resize(nElectrons) ;
+  pflowCores_.assign(nElectrons,-1) ;
+  for ( unsigned i=0 ; i<nElectrons ; ++i )
+   {
+    const GsfTrackRef & gsfTrackRef = electrons[i]->gsfTrack() ;
+    gsfTrackIds_[i] = gsfTrackRef.id() ;
+    gsfTrackKeys_[i] = gsfTrackRef.key() ;
+   }
 
-  // add pflow info
+  // add pflow info : the pflow cores are sorted by gsf track, so that
+  // each core finds its partner with a binary search instead of a full scan,
+  // the first one in the pflow collection being used in case of duplicates
   const GsfElectronCoreCollection * pfCoresCollection = pfCoresH_.product() ;
-  GsfElectronCoreCollection::const_iterator pfCoreIter ;
-  std::list<GsfElectronCore *>::iterator eleCore ;
-  bool found ;
-  for ( eleCore = electrons.begin() ; eleCore != electrons.end() ; eleCore++ )
+  pflowKeys_.clear() ;
+  for ( unsigned j=0 ; j<pfCoresCollection->size() ; ++j )
+   {
+    const GsfTrackRef & gsfTrackRef = (*pfCoresCollection)[j].gsfTrack() ;
+    pflowKeys_.push_back(PflowKey(gsfTrackRef.id(),gsfTrackRef.key(),j)) ;
+   }
+  std::sort(pflowKeys_.begin(),pflowKeys_.end()) ;
+  for ( unsigned i=0 ; i<nElectrons ; ++i )
    {
 //    (*eleCore)->setPflowSuperCluster((*pfClusterTracksH_)[(*eleCore)->gsfTrack()]) ;
-    found = false ;
-    for
-     ( pfCoreIter = pfCoresCollection->begin() ;
-       pfCoreIter != pfCoresCollection->end() ;
-       pfCoreIter++ )
+    PflowKey searched(gsfTrackIds_[i],gsfTrackKeys_[i],0) ;
+    std::vector<PflowKey>::const_iterator pflowKey
+     = std::lower_bound(pflowKeys_.begin(),pflowKeys_.end(),searched) ;
+    for ( ; (pflowKey!=pflowKeys_.end())&&pflowKey->sameTrack(searched) ; ++pflowKey )
      {
-      if (pfCoreIter->gsfTrack()==(*eleCore)->gsfTrack())
+      if (pflowCores_[i]>=0)
+       { edm::LogWarning("GsfElectronCoreProducer")<<"associated pfGsfElectronCore already found" ; }
+      else
        {
-        if (found)
-         {
-          edm::LogWarning("GsfElectronCoreProducer")<<"associated pfGsfElectronCore already found" ;
-         }
-        else
-         {
-          found = true ;
-          (*eleCore)->setPflowSuperCluster(pfCoreIter->pflowSuperCluster()) ;
-         }
+        pflowCores_[i] = pflowKey->index ;
+        electrons[i]->setPflowSuperCluster((*pfCoresCollection)[pflowKey->index].pflowSuperCluster()) ;
        }
      }
    }
 
-  // store
-  std::auto_ptr<GsfElectronCoreCollection> collection(new GsfElectronCoreCollection) ;
-  for ( eleCore = electrons.begin() ; eleCore != electrons.end() ; eleCore++ )
+  // remove the cores without any supercluster, by compaction of the indices
+  selected_.clear() ;
+  for ( unsigned i=0 ; i<nElectrons ; ++i )
    {
-    if ((*eleCore)->superCluster().isNull())
+    if (electrons[i]->superCluster().isNull())
      { LogDebug("GsfElectronCoreProducer")<<"GsfTrack with no associated SuperCluster at all." ; }
     else
-     { collection->push_back(**eleCore) ; }
-    delete (*eleCore) ;
+     { selected_.push_back(i) ; }
    }
+
+  // store
+  std::auto_ptr<GsfElectronCoreCollection> collection(new GsfElectronCoreCollection) ;
+  collection->reserve(selected_.size()) ;
+  std::vector<unsigned>::const_iterator iselected ;
+  for ( iselected = selected_.begin() ; iselected != selected_.end() ; ++iselected )
+   { collection->push_back(*electrons[*iselected]) ; }
+  ElectronCoreVector::iterator eleCore ;
+  for ( eleCore = electrons.begin() ; eleCore != electrons.end() ; ++eleCore )
+   { deleteElectronCore(*eleCore) ; }
+  electrons.clear() ;
   event.put(collection) ;
+  GsfElectronCoreBaseProducer::endEvent(event) ;
  }
 
-void GsfElectronCoreProducer::produceTrackerDrivenCore( const GsfTrackRef & gsfTrackRef, std::list<GsfElectronCore *> & electrons )
+void GsfElectronCoreProducer::produceTrackerDrivenCore( const GsfTrackRef & gsfTrackRef, ElectronCoreVector & electrons )
  {
-  GsfElectronCore * eleCore = new GsfElectronCore(gsfTrackRef) ;
+  GsfElectronCore * eleCore = newElectronCore(gsfTrackRef) ;
   if (eleCore->ecalDrivenSeed())
-   { delete eleCore ; return ; }
-  GsfElectronCoreBaseProducer::fillElectronCore(eleCore) ;
+   { deleteElectronCore(eleCore) ; return ; }
   electrons.push_back(eleCore) ;
  }
 
@@ -5,6 +5,7 @@
 #include "DataFormats/EgammaCandidates/interface/GsfElectronCoreFwd.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
 
 class GsfElectronCoreProducer : public GsfElectronCoreBaseProducer
  {
@@ -28,7 +29,29 @@ class GsfElectronCoreProducer : public GsfElectronCoreBaseProducer
 //    edm::Handle<reco::SuperClusterCollection> pfClustersH_ ;
 //    edm::Handle<edm::ValueMap<reco::SuperClusterRef> > pfClusterTracksH_ ;
 
-    void produceTrackerDrivenCore( const reco::GsfTrackRef & gsfTrackRef, std::list<reco::GsfElectronCore *> & electrons ) ;
+    void produceTrackerDrivenCore( const reco::GsfTrackRef & gsfTrackRef, ElectronCoreVector & electrons ) ;
+
+    // hot fields of the transient cores, in structure-of-arrays form,
+    // kept from one event to the next so to reuse the memory
+    std::vector<edm::ProductID> gsfTrackIds_ ;
+    std::vector<unsigned> gsfTrackKeys_ ;
+    std::vector<int> pflowCores_ ; // index of the associated pflow core, or -1
+    std::vector<unsigned> selected_ ;
+
+    // pflow cores sorted by gsf track
+    struct PflowKey
+     {
+      edm::ProductID id ; unsigned key ; unsigned index ;
+      PflowKey( const edm::ProductID & i, unsigned k, unsigned n ) : id(i), key(k), index(n) {}
+      bool sameTrack( const PflowKey & other ) const { return (id==other.id)&&(key==other.key) ; }
+      bool operator<( const PflowKey & other ) const
+       {
+        if (id!=other.id) return id<other.id ;
+        if (key!=other.key) return key<other.key ;
+        return index<other.index ;
+       }
+     } ;
+    std::vector<PflowKey> pflowKeys_ ;
 
  } ;
 
@@ -71,6 +71,7 @@ GsfElectronEcalDrivenProducer::~GsfElectronEcalDrivenProducer()
 // ------------ method called to produce the data  ------------
 void GsfElectronEcalDrivenProducer::produce( edm::Event & event, const edm::EventSetup & setup )
  {
+  if (skipEvent(event)) return ;
   beginEvent(event,setup) ;
   algo_->completeElectrons() ;
   fillEvent(event) ;
@@ -88,6 +88,7 @@ GsfElectronProducer::~GsfElectronProducer()
 
 void GsfElectronProducer::produce( edm::Event & event, const edm::EventSetup & setup )
  {
+  if (skipEvent(event)) return ;
   beginEvent(event,setup) ;
   algo_->clonePreviousElectrons() ;
   // don't add pflow only electrons if one so wish
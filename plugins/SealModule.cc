@@ -15,6 +15,7 @@
 //#include "GlobalGsfElectronProducer.h"
 
 #include "GEDGsfElectronCoreProducer.h"
+#include "ElectronEventGuard.h"
 
 DEFINE_FWK_MODULE(SiStripElectronProducer);
 DEFINE_FWK_MODULE(SiStripElectronAssociator);
@@ -27,4 +28,5 @@ DEFINE_FWK_MODULE(GsfElectronProducer);
 //DEFINE_FWK_MODULE(GlobalGsfElectronProducer);
 DEFINE_FWK_MODULE(SiStripElectronSeedProducer);
 DEFINE_FWK_MODULE(GEDGsfElectronCoreProducer);
+DEFINE_FWK_MODULE(ElectronEventGuard);
 
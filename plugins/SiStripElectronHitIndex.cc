@@ -0,0 +1,112 @@
+
+#include "SiStripElectronHitIndex.h"
+
+#include "ElectronTrackerModuleTable.h"
+
+#include "DataFormats/GeometryVector/interface/LocalPoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+SiStripElectronHitIndex::SiStripElectronHitIndex( unsigned nPhiBins )
+ : nPhiBins_(nPhiBins>0?nPhiBins:1),
+   phiBinWidth_(2.*M_PI/nPhiBins_), rMax_(0.), binBegin_(nPhiBins_+1,0)
+ {}
+
+void SiStripElectronHitIndex::clear()
+ {
+  entries_.clear() ;
+  r_.clear() ; phi_.clear() ;
+  rMax_ = 0. ;
+  std::fill(binBegin_.begin(),binBegin_.end(),0) ;
+ }
+
+unsigned SiStripElectronHitIndex::phiBin( float phi ) const
+ {
+  int bin = static_cast<int>(std::floor((phi+M_PI)/phiBinWidth_)) ;
+  bin %= static_cast<int>(nPhiBins_) ;
+  if (bin<0) bin += nPhiBins_ ;
+  return bin ;
+ }
+
+// the table being built from the same geometry, all the modules,
+// including the glued ones of the matched hits, are known
+template <typename HitCollection>
+void SiStripElectronHitIndex::fill
+ ( const ElectronTrackerModuleTable & modules, const HitCollection & hits )
+ {
+  typename HitCollection::const_iterator detSet ;
+  for ( detSet = hits.begin() ; detSet != hits.end() ; ++detSet )
+   {
+    int module = modules.index(detSet->detId()) ;
+    if (module<0) continue ;
+    typename HitCollection::DetSet::const_iterator hit ;
+    for ( hit = detSet->begin() ; hit != detSet->end() ; ++hit )
+     {
+      LocalPoint local = hit->localPosition() ;
+      float x, y, z ;
+      modules.toGlobal(module,local.x(),local.y(),x,y,z) ;
+      Entry entry ;
+      entry.r = std::sqrt(x*x+y*y) ;
+      entry.phi = std::atan2(y,x) ;
+      entry.bin = phiBin(entry.phi) ;
+      entries_.push_back(entry) ;
+     }
+   }
+ }
+
+void SiStripElectronHitIndex::build
+ ( const ElectronTrackerModuleTable & modules,
+   const SiStripRecHit2DCollection & rphiHits,
+   const SiStripRecHit2DCollection & stereoHits,
+   const SiStripMatchedRecHit2DCollection & matchedHits )
+ {
+  clear() ;
+  fill(modules,rphiHits) ;
+  fill(modules,stereoHits) ;
+  fill(modules,matchedHits) ;
+  std::sort(entries_.begin(),entries_.end()) ;
+
+  unsigned n = entries_.size() ;
+  r_.resize(n) ; phi_.resize(n) ;
+  for ( unsigned i=0 ; i<n ; ++i )
+   {
+    const Entry & entry = entries_[i] ;
+    r_[i] = entry.r ; phi_[i] = entry.phi ;
+    if (entry.r>rMax_) rMax_ = entry.r ;
+    ++binBegin_[entry.bin+1] ;
+   }
+  for ( unsigned bin=0 ; bin<nPhiBins_ ; ++bin )
+   { binBegin_[bin+1] += binBegin_[bin] ; }
+ }
+
+unsigned SiStripElectronHitIndex::countInBand
+ ( float phi, float rRef, float curvature, float dPhi, unsigned maxCount ) const
+ {
+  unsigned counter = 0 ;
+  if (r_.empty()) return counter ;
+
+  // widest band, at the largest radius
+  float bend = std::asin(std::min(1.f,curvature*std::max(rMax_,rRef))) ;
+  float maxDPhi = bend+dPhi ;
+  int firstBin = static_cast<int>(std::floor((phi-maxDPhi+M_PI)/phiBinWidth_)) ;
+  int lastBin = static_cast<int>(std::floor((phi+maxDPhi+M_PI)/phiBinWidth_)) ;
+  int nBins = std::min(lastBin-firstBin+1,static_cast<int>(nPhiBins_)) ;
+  for ( int ibin=0 ; ibin<nBins ; ++ibin )
+   {
+    int bin = (firstBin+ibin)%static_cast<int>(nPhiBins_) ;
+    if (bin<0) bin += nPhiBins_ ;
+    for ( unsigned i=binBegin_[bin] ; i<binBegin_[bin+1] ; ++i )
+     {
+      float dphi = phi_[i]-phi ;
+      if (dphi>M_PI) dphi -= 2.*M_PI ;
+      else if (dphi<-M_PI) dphi += 2.*M_PI ;
+      float band = std::asin(std::min(1.f,curvature*std::max(r_[i],rRef)))+dPhi ;
+      if (std::abs(dphi)<=band)
+       {
+        if (++counter>=maxCount) return counter ;
+       }
+     }
+   }
+  return counter ;
+ }
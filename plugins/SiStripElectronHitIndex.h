@@ -0,0 +1,66 @@
+
+#ifndef SiStripElectronHitIndex_h
+#define SiStripElectronHitIndex_h
+
+//
+// Package:         RecoEgamma/EgammaElectronProducers
+// Class:           SiStripElectronHitIndex
+//
+// Description:     Per-event copy of the global positions of the rphi, stereo
+//                  and matched strip hits, bucketed in phi, so that the phi
+//                  band of a supercluster only visits the hits of the
+//                  relevant buckets.
+
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2DCollection.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2DCollection.h"
+
+#include <vector>
+
+class ElectronTrackerModuleTable ;
+
+class SiStripElectronHitIndex
+ {
+  public:
+
+    explicit SiStripElectronHitIndex( unsigned nPhiBins =64 ) ;
+
+    // to be called once per event
+    void build
+     ( const ElectronTrackerModuleTable &,
+       const SiStripRecHit2DCollection & rphiHits,
+       const SiStripRecHit2DCollection & stereoHits,
+       const SiStripMatchedRecHit2DCollection & matchedHits ) ;
+    void clear() ;
+    unsigned size() const { return r_.size() ; }
+
+    // number of hits, up to maxCount, such as |dphi|<=asin(min(1,curvature*max(r,rRef)))+dPhi,
+    // that is the band of both charge hypotheses of a track with the given
+    // half curvature (0.003*B/2/pt, in 1/cm), going through (rRef,phi)
+    unsigned countInBand
+     ( float phi, float rRef, float curvature, float dPhi, unsigned maxCount ) const ;
+
+  private:
+
+    struct Entry
+     {
+      unsigned bin ; float r, phi ;
+      bool operator<( const Entry & other ) const
+       { return bin<other.bin ; }
+     } ;
+
+    template <typename HitCollection>
+    void fill( const ElectronTrackerModuleTable &, const HitCollection & ) ;
+    unsigned phiBin( float phi ) const ;
+
+    unsigned nPhiBins_ ;
+    float phiBinWidth_ ;
+    float rMax_ ;
+
+    std::vector<Entry> entries_ ; // scratch for sorting
+
+    std::vector<float> r_ ;
+    std::vector<float> phi_ ;
+    std::vector<unsigned> binBegin_ ; // nPhiBins_+1 offsets in the arrays above
+ } ;
+
+#endif
@@ -32,6 +32,11 @@
 #include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2DCollection.h"
 #include "MagneticField/Engine/interface/MagneticField.h"
 #include "MagneticField/Records/interface/IdealMagneticFieldRecord.h" 
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/Records/interface/IdealGeometryRecord.h"
+
+#include <cmath>
 
 //
 // constants, enums and typedefs
@@ -45,6 +50,8 @@
 // constructors and destructor
 //
 SiStripElectronProducer::SiStripElectronProducer(const edm::ParameterSet& iConfig)
+   : hitIndexPrecheck_(false), bFieldZ_(0.),
+     trackerCacheId_(0), magneticFieldCacheId_(0), trackerTopologyCacheId_(0)
 {
    // register your products
    siStripElectronsLabel_ = iConfig.getParameter<std::string>("siStripElectronsLabel");
@@ -61,14 +68,21 @@ SiStripElectronProducer::SiStripElectronProducer(const edm::ParameterSet& iConfi
    superClusterProducer_ = iConfig.getParameter<std::string>("superClusterProducer");
    superClusterCollection_ = iConfig.getParameter<std::string>("superClusterCollection");
    
+   phiBandWidth_ = iConfig.getParameter<double>("phiBandWidth");      // this is in radians
+   minHits_ = iConfig.getParameter<int32_t>("minHits");
+
    algo_p = new SiStripElectronAlgo(
       iConfig.getParameter<int32_t>("maxHitsOnDetId"),
       iConfig.getParameter<double>("originUncertainty"),
-      iConfig.getParameter<double>("phiBandWidth"),      // this is in radians
+      phiBandWidth_,
       iConfig.getParameter<double>("maxNormResid"),
-      iConfig.getParameter<int32_t>("minHits"),
+      minHits_,
       iConfig.getParameter<double>("maxReducedChi2"));
 
+   if (iConfig.exists("hitIndexPrecheck")) {
+      hitIndexPrecheck_ = iConfig.getParameter<bool>("hitIndexPrecheck");
+   }
+
    LogDebug("") << " Welcome to SiStripElectronProducer " ;
 
 }
@@ -102,13 +116,60 @@ SiStripElectronProducer::~SiStripElectronProducer()
 // member functions
 //
 
+// Conservative necessary condition for findElectron : at least minHits
+// rphi, stereo or matched strip hits in the band of both charge hypotheses,
+// with a doubled phiBandWidth, the bending being computed with pt rather
+// than energy.
+bool
+SiStripElectronProducer::mayFindElectron(const reco::SuperCluster& sc) const
+{
+   if (!hitIndexPrecheck_) return true;
+   if (minHits_ <= 0) return true;
+   double pt = sc.energy() / cosh(sc.eta());
+   if (pt <= 0.) return true;
+   double curvature = 3.00e-3 * fabs(bFieldZ_) / pt / 2.;
+   unsigned count = hitIndex_.countInBand(sc.phi(), sc.position().rho(), curvature, 2.*phiBandWidth_, minHits_);
+   return count >= unsigned(minHits_);
+}
+
+// The handles are kept from one event to the next, and only fetched
+// again, with the derived data, when their record has changed.
+void
+SiStripElectronProducer::checkSetup(const edm::EventSetup& iSetup)
+{
+   unsigned long long trackerCacheId = iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier();
+   if (trackerCacheId != trackerCacheId_) {
+      iSetup.get<TrackerDigiGeometryRecord>().get(trackerHandle_);
+      trackerCacheId_ = trackerCacheId;
+      moduleTable_.clear();
+   }
+   if (hitIndexPrecheck_ && moduleTable_.size() == 0) {
+      moduleTable_.build(*trackerHandle_);
+   }
+
+   unsigned long long magneticFieldCacheId = iSetup.get<IdealMagneticFieldRecord>().cacheIdentifier();
+   if (magneticFieldCacheId != magneticFieldCacheId_) {
+      iSetup.get<IdealMagneticFieldRecord>().get(magneticFieldHandle_);
+      magneticFieldCacheId_ = magneticFieldCacheId;
+      bFieldZ_ = magneticFieldHandle_->inTesla(GlobalPoint(0., 0., 0.)).z();
+   }
+
+   unsigned long long trackerTopologyCacheId = iSetup.get<IdealGeometryRecord>().cacheIdentifier();
+   if (trackerTopologyCacheId != trackerTopologyCacheId_) {
+      iSetup.get<IdealGeometryRecord>().get(trackerTopologyHandle_);
+      trackerTopologyCacheId_ = trackerTopologyCacheId;
+   }
+}
+
 // ------------ method called to produce the data  ------------
 void
 SiStripElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 {
+   checkSetup(iSetup);
+   const edm::ESHandle<TrackerGeometry>& trackerHandle = trackerHandle_;
+   const edm::ESHandle<MagneticField>& magneticFieldHandle = magneticFieldHandle_;
+
    // Extract data from the event
-   edm::ESHandle<TrackerGeometry> trackerHandle;
-   iSetup.get<TrackerDigiGeometryRecord>().get(trackerHandle);
 
    edm::Handle<SiStripRecHit2DCollection> rphiHitsHandle;
    iEvent.getByLabel(siHitProducer_, siRphiHitCollection_, rphiHitsHandle);
@@ -119,29 +180,28 @@ SiStripElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSet
    edm::Handle<SiStripMatchedRecHit2DCollection> matchedHitsHandle;
    iEvent.getByLabel(siHitProducer_, siMatchedHitCollection_, matchedHitsHandle);
 
-   edm::ESHandle<MagneticField> magneticFieldHandle;
-   iSetup.get<IdealMagneticFieldRecord>().get(magneticFieldHandle);
-
    edm::Handle<reco::SuperClusterCollection> superClusterHandle;
    iEvent.getByLabel(superClusterProducer_, superClusterCollection_, superClusterHandle);
 
-   // Set up SiStripElectronAlgo for this event
-   algo_p->prepareEvent(trackerHandle, rphiHitsHandle, stereoHitsHandle, matchedHitsHandle, magneticFieldHandle);
-
    // Prepare the output electron candidates and clouds to be filled
    std::auto_ptr<reco::SiStripElectronCollection> electronOut(new reco::SiStripElectronCollection);
    std::auto_ptr<TrackCandidateCollection> trackCandidateOut(new TrackCandidateCollection);
 
    //Retrieve tracker topology from geometry
-   edm::ESHandle<TrackerTopology> tTopoHand;
-   iSetup.get<IdealGeometryRecord>().get(tTopoHand);
-   const TrackerTopology *tTopo=tTopoHand.product();
+   const TrackerTopology *tTopo=trackerTopologyHandle_.product();
+
+   // Index the strip hits once for all the superclusters
+   if (hitIndexPrecheck_) {
+      hitIndex_.build(moduleTable_, *rphiHitsHandle, *stereoHitsHandle, *matchedHitsHandle);
+   }
 
    // counter for electron candidates
    int siStripElectCands = 0 ;
 
    std::ostringstream str;
 
+   // Set up SiStripElectronAlgo for this event
+   algo_p->prepareEvent(trackerHandle, rphiHitsHandle, stereoHitsHandle, matchedHitsHandle, magneticFieldHandle);
 
    // Loop over clusters
    str << "Starting loop over superclusters."<< "\n" << std::endl;
@@ -149,12 +209,13 @@ SiStripElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSet
       const reco::SuperCluster* sc = &(*reco::SuperClusterRef(superClusterHandle, i));
       double energy = sc->energy();
 
-      if (algo_p->findElectron(*electronOut, *trackCandidateOut, reco::SuperClusterRef(superClusterHandle, i),tTopo)) {
-	str << "Supercluster energy: " << energy << ", FOUND an electron." << "\n" << std::endl;
-	 ++siStripElectCands ;
+      if (mayFindElectron(*sc) &&
+          algo_p->findElectron(*electronOut, *trackCandidateOut, reco::SuperClusterRef(superClusterHandle, i),tTopo)) {
+         str << "Supercluster energy: " << energy << ", FOUND an electron." << "\n" << std::endl;
+         ++siStripElectCands ;
       }
       else {
-	 str << "Supercluster energy: " << energy << ", DID NOT FIND an electron."<< "\n" << std::endl;
+         str << "Supercluster energy: " << energy << ", DID NOT FIND an electron."<< "\n" << std::endl;
       }
    }
    str << "Ending loop over superclusters." << "\n" << std::endl;
@@ -168,6 +229,7 @@ SiStripElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSet
    // Put the electron candidates and the tracking trajectories into the event
    iEvent.put(electronOut, siStripElectronsLabel_);
    iEvent.put(trackCandidateOut, trackCandidatesLabel_);
+   hitIndex_.clear();
 }
 
 //
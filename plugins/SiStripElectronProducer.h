@@ -25,11 +25,18 @@
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/ESHandle.h"
 
 #include "DataFormats/EgammaCandidates/interface/SiStripElectron.h"
 #include "RecoEgamma/EgammaElectronAlgos/interface/SiStripElectronAlgo.h"
+#include "SiStripElectronHitIndex.h"
+#include "ElectronTrackerModuleTable.h"
+
 
 // forward declarations
+class TrackerGeometry;
+class MagneticField;
+class TrackerTopology;
 
 class SiStripElectronProducer : public edm::EDProducer {
    public:
@@ -39,6 +46,9 @@ class SiStripElectronProducer : public edm::EDProducer {
 
       virtual void produce(edm::Event&, const edm::EventSetup&);
    private:
+      bool mayFindElectron(const reco::SuperCluster&) const;
+      void checkSetup(const edm::EventSetup&);
+
       // ----------member data ---------------------------
       std::string siHitProducer_;
       std::string siRphiHitCollection_;
@@ -49,7 +59,27 @@ class SiStripElectronProducer : public edm::EDProducer {
       std::string siStripElectronsLabel_;
       std::string trackCandidatesLabel_;
 
+      // algo parameters also used by the precheck
+      double phiBandWidth_;
+      int32_t minHits_;
+
       SiStripElectronAlgo* algo_p;
+
+      // optional per-event index of the strip hits, used to skip the
+      // superclusters whose phi band cannot contain minHits hits
+      bool hitIndexPrecheck_;
+      SiStripElectronHitIndex hitIndex_;
+      double bFieldZ_;
+
+      // EventSetup products, only fetched again when their record has a
+      // new IOV, with the flat module table derived from the geometry
+      edm::ESHandle<TrackerGeometry> trackerHandle_;
+      unsigned long long trackerCacheId_;
+      edm::ESHandle<MagneticField> magneticFieldHandle_;
+      unsigned long long magneticFieldCacheId_;
+      edm::ESHandle<TrackerTopology> trackerTopologyHandle_;
+      unsigned long long trackerTopologyCacheId_;
+      ElectronTrackerModuleTable moduleTable_;
 };
 
 #endif
@@ -70,17 +70,23 @@ void SiStripElectronSeedProducer::produce(edm::Event& e, const edm::EventSetup&
   LogDebug("entering");
   LogDebug("")  <<"[SiStripElectronSeedProducer::produce] entering " ;
 
-  matcher_->setupES(iSetup);
-
   ElectronSeedCollection *seeds = new ElectronSeedCollection;
   std::auto_ptr<ElectronSeedCollection> pSeeds;
 
+  // the generator fetches and matches the strip hits at each run call,
+  // so that empty supercluster collections are not given to it
+  bool esReady = false;
+
   // do both barrel and endcap instances
   for (unsigned int i=0; i<2; i++) {
 
     // get the superclusters
     edm::Handle<SuperClusterCollection> clusters;
-    if(e.getByLabel(superClusters_[i],clusters)) {
+    if(e.getByLabel(superClusters_[i],clusters) && !clusters->empty()) {
+      if (!esReady) {
+        matcher_->setupES(iSetup);
+        esReady = true;
+      }
       // run the seed generator and put the ElectronSeeds into a collection
       matcher_->run(e,iSetup,clusters,*seeds);
     }
@@ -6,6 +6,16 @@ ecalDrivenElectronSeedsParameters = cms.PSet(
     fromTrackerSeeds = cms.bool(True),
     initialSeeds = cms.InputTag("newCombinedSeeds"),
     preFilteredSeeds = cms.bool(False),
+    rebuildSeedFilterEachRun = cms.bool(True), ## False : SeedFilter only rebuilt on an IOV change of its records (see the SeedFilterRuns Oval job)
+    adaptiveSeeding = cms.bool(False), ## per event choice between initial and prefiltered seeds (needs the SeedFilter configuration)
+    adaptiveMaxSuperClusters = cms.uint32(2), ## prefiltered seeds if no more superclusters above SCEtCut...
+    adaptiveMinInitialSeeds = cms.uint32(20000), ## ...and at least that many initial seeds
+    skippedRegionsDeltaR = cms.double(0.), ## prefiltered seeds : no region for superclusters closer than that to a seeded one (lossy)
+    removeDuplicatedSeeds = cms.bool(False), ## prefiltered seeds : keep only one copy of identical seeds (changes the output)
+    mergeSeedsWithIdenticalHits = cms.bool(False), ## only one seed per supercluster and hit content
+    initialSeedsPhiRoads = cms.bool(False), ## each supercluster only sees the initial seeds of its phi road (checked with electronSeedsPhiRoads_cfg.py)
+    maxSuperClusters = cms.uint32(0), ## work budget, superclusters by decreasing Et, 0 for none
+    maxSeedMatchingIterations = cms.uint32(0), ## work budget, initial seeds given to the matcher, 0 for none
     useRecoVertex = cms.bool(False),
     vertices = cms.InputTag("offlinePrimaryVerticesWithBS"),
     beamSpot = cms.InputTag("offlineBeamSpot"),
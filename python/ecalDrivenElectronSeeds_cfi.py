@@ -10,6 +10,10 @@ from RecoEgamma.EgammaElectronProducers.ecalDrivenElectronSeedsParameters_cff im
 ecalDrivenElectronSeeds = cms.EDProducer("ElectronSeedProducer",
     barrelSuperClusters = cms.InputTag("correctedHybridSuperClusters"),
     endcapSuperClusters = cms.InputTag("correctedMulti5x5SuperClustersWithPreshower"),
+    eventGuard = cms.InputTag(""), ## see electronEventGuard_cfi
+    regionalCandidates = cms.InputTag(""), ## trigger candidates for the regional mode (e.g. l1extraParticles:Isolated)
+    regionalCandidateMinEt = cms.double(0.),
+    regionalDeltaR = cms.double(0.5),
     SeedConfiguration = cms.PSet(
         ecalDrivenElectronSeedsParameters,
 #        OrderedHitsFactoryPSet = cms.PSet(
@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+#
+# Tells whether the event has at least one supercluster passing the Et cut
+# of the ecal seeding. Its result can be given as eventGuard to the ecal
+# driven electron producers, which then put empty collections at once.
+# With filter = True, it also stops the path.
+#
+electronEventGuard = cms.EDFilter("ElectronEventGuard",
+    barrelSuperClusters = cms.InputTag("correctedHybridSuperClusters"),
+    endcapSuperClusters = cms.InputTag("correctedMulti5x5SuperClustersWithPreshower"),
+    beamSpot = cms.InputTag("offlineBeamSpot"),
+    SCEtCut = cms.double(4.0),
+    filter = cms.bool(False)
+)
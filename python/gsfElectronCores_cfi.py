@@ -4,7 +4,10 @@ ecalDrivenGsfElectronCores = cms.EDProducer("GsfElectronCoreEcalDrivenProducer",
     gsfPfRecTracks = cms.InputTag("pfTrackElec"),
     gsfTracks = cms.InputTag("electronGsfTracks"),
     ctfTracks = cms.InputTag("generalTracks"),
-    useGsfPfRecTracks = cms.bool(True)
+    useGsfPfRecTracks = cms.bool(True),
+    eventGuard = cms.InputTag(""), ## see electronEventGuard_cfi
+    maxElectronCores = cms.uint32(0), ## work budget, 0 for none
+    maxCtfAssociationIterations = cms.uint32(0) ## work budget, 0 for none
 )
 
 gsfElectronCores = cms.EDProducer("GsfElectronCoreProducer",
@@ -14,6 +17,8 @@ gsfElectronCores = cms.EDProducer("GsfElectronCoreProducer",
     gsfTracks = cms.InputTag("electronGsfTracks"),
     ctfTracks = cms.InputTag("generalTracks"),
     useGsfPfRecTracks = cms.bool(True),
+    maxElectronCores = cms.uint32(0), ## work budget, 0 for none
+    maxCtfAssociationIterations = cms.uint32(0), ## work budget, 0 for none
     pfSuperClusters = cms.InputTag("pfElectronTranslator:pf"),
     pfSuperClusterTrackMap = cms.InputTag("pfElectronTranslator:pf")
 )
@@ -20,6 +20,7 @@ ecalDrivenGsfElectrons = cms.EDProducer("GsfElectronEcalDrivenProducer",
     seedsTag = cms.InputTag("ecalDrivenElectronSeeds"),
     beamSpotTag = cms.InputTag("offlineBeamSpot"),
     gsfPfRecTracksTag = cms.InputTag("pfTrackElec"),
+    eventGuard = cms.InputTag(""), ## see electronEventGuard_cfi
     
     # backward compatibility mechanism for ctf tracks
     ctfTracksCheck = cms.bool(True),
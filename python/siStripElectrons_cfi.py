@@ -21,7 +21,8 @@ siStripElectrons = cms.EDProducer("SiStripElectronProducer",
 
     maxNormResid = cms.double(10.0),
     siMatchedHitCollection = cms.string('matchedRecHit'),
-    superClusterCollection = cms.string('')
+    superClusterCollection = cms.string(''),
+    hitIndexPrecheck = cms.bool(False) ## skip superclusters with too few hits in their phi band (checked with siStripElectronsPrecheck_cfg.py)
 )
 
 
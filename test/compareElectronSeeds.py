@@ -0,0 +1,35 @@
+#!/usr/bin/env python
+
+# Compares, event by event, the electron seeds of two ElectronSeedProducer
+# modules, given as arguments (by default the ones of
+# electronSeedsPhiRoads_cfg.py, without and with the phi roads), and exits
+# with a non zero status at the first difference.
+
+import os, sys
+from DataFormats.FWLite import Events, Handle
+
+def seedSummary(seed):
+  state = seed.startingState()
+  return (seed.caloCluster().key(),seed.nHits(),state.detId(),
+          seed.dPhi1(),seed.dRz1(),seed.dPhi1Pos(),seed.dRz1Pos())
+
+def compare(labels):
+  seeds = [ Handle("std::vector<reco::ElectronSeed>"), Handle("std::vector<reco::ElectronSeed>") ]
+  nEvents = 0
+  for event in Events(os.environ['TEST_RECO_FILE']):
+    for i in range(2):
+      event.getByLabel(labels[i],seeds[i])
+    reference = sorted([ seedSummary(s) for s in seeds[0].product() ])
+    tested = sorted([ seedSummary(s) for s in seeds[1].product() ])
+    if reference != tested:
+      print "run", event.eventAuxiliary().run(), "event", event.eventAuxiliary().event(), ": different seeds,", len(reference), "from", labels[0], "and", len(tested), "from", labels[1]
+      return 1
+    nEvents += 1
+  print "identical seeds from", labels[0], "and", labels[1], "in", nEvents, "events"
+  return 0
+
+if __name__ == "__main__":
+  labels = [ "ecalDrivenElectronSeeds", "ecalDrivenElectronSeedsPhiRoads" ]
+  if len(sys.argv)==3:
+    labels = sys.argv[1:3]
+  sys.exit(compare(labels))
@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+
+# Compares, event by event, the products of SiStripElectronProducer without
+# and with the hit index precheck, written by siStripElectronsPrecheck_cfg.py,
+# and exits with a non zero status at the first difference.
+
+import os, sys
+from DataFormats.FWLite import Events, Handle
+
+def electronSummary(electron):
+  hits = []
+  for hit in electron.rphiRecHits():
+    hits.append((hit.geographicalId().rawId(),hit.localPosition().x(),hit.localPosition().y()))
+  for hit in electron.stereoRecHits():
+    hits.append((hit.geographicalId().rawId(),hit.localPosition().x(),hit.localPosition().y()))
+  return (electron.superCluster().key(),electron.charge(),electron.px(),electron.py(),electron.pz(),hits)
+
+def candidateSummary(candidate):
+  return (candidate.nRecHits(),candidate.seed().nHits())
+
+def compare():
+  electrons = [ Handle("std::vector<reco::SiStripElectron>"), Handle("std::vector<reco::SiStripElectron>") ]
+  candidates = [ Handle("std::vector<TrackCandidate>"), Handle("std::vector<TrackCandidate>") ]
+  labels = [ "siStripElectrons", "siStripElectronsPrecheck" ]
+  nEvents = 0
+  for event in Events(os.environ['TEST_RECO_FILE']):
+    for i in range(2):
+      event.getByLabel(labels[i],electrons[i])
+      event.getByLabel(labels[i],candidates[i])
+    whole = [ electronSummary(e) for e in electrons[0].product() ]
+    prechecked = [ electronSummary(e) for e in electrons[1].product() ]
+    if whole != prechecked:
+      print "event", event.eventAuxiliary().event(), ": different electrons", len(whole), "without and", len(prechecked), "with the precheck"
+      return 1
+    whole = [ candidateSummary(c) for c in candidates[0].product() ]
+    prechecked = [ candidateSummary(c) for c in candidates[1].product() ]
+    if whole != prechecked:
+      print "event", event.eventAuxiliary().event(), ": different track candidates"
+      return 1
+    nEvents += 1
+  print "identical products without and with the precheck in", nEvents, "events"
+  return 0
+
+if __name__ == "__main__":
+  sys.exit(compare())
@@ -0,0 +1,60 @@
+import FWCore.ParameterSet.Config as cms
+import os
+
+# Runs the prefiltered ElectronSeedProducer twice on events of two runs,
+# with the SeedFilter rebuilt for each run (former behaviour) and only on
+# an IOV change of its records, the products being then compared with
+# compareElectronSeeds.py, which fails if they differ.
+
+process = cms.Process("electrons")
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.Geometry_cff")
+process.load("Configuration.StandardSequences.MagneticField_38T_cff")
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.load("Configuration.StandardSequences.RawToDigi_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:'+os.environ['TEST_RAW_FILE'])
+)
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.ecalDrivenElectronSeedsEachRun = process.ecalDrivenElectronSeeds.clone()
+process.ecalDrivenElectronSeedsEachRun.SeedConfiguration.preFilteredSeeds = True
+process.ecalDrivenElectronSeedsEachRun.SeedConfiguration.rebuildSeedFilterEachRun = True
+process.ecalDrivenElectronSeedsEachRun.SeedConfiguration.OrderedHitsFactoryPSet = cms.PSet(
+    ComponentName = cms.string('StandardHitPairGenerator'),
+    SeedingLayers = cms.string('MixedLayerPairs')
+)
+process.ecalDrivenElectronSeedsEachRun.SeedConfiguration.TTRHBuilder = cms.string('WithTrackAngle')
+process.ecalDrivenElectronSeedsEachRun.SeedConfiguration.RegionPSet = cms.PSet(
+    deltaPhiRegion = cms.double(0.7),
+    originHalfLength = cms.double(15.0),
+    useZInVertex = cms.bool(True),
+    deltaEtaRegion = cms.double(0.3),
+    ptMin = cms.double(1.5),
+    originRadius = cms.double(0.2),
+    VertexProducer = cms.InputTag("pixelVertices")
+)
+process.ecalDrivenElectronSeedsOnIov = process.ecalDrivenElectronSeedsEachRun.clone()
+process.ecalDrivenElectronSeedsOnIov.SeedConfiguration.rebuildSeedFilterEachRun = False
+
+process.out = cms.OutputModule("PoolOutputModule",
+    outputCommands = cms.untracked.vstring('drop *',
+        'keep *_ecalDrivenElectronSeedsEachRun_*_electrons',
+        'keep *_ecalDrivenElectronSeedsOnIov_*_electrons'),
+    fileName = cms.untracked.string(os.environ['TEST_RECO_FILE'])
+)
+
+process.mylocalreco = cms.Sequence(process.trackerlocalreco*process.calolocalreco)
+process.myglobalreco = cms.Sequence(process.offlineBeamSpot+process.recopixelvertexing*process.ecalClusters)
+
+process.p = cms.Path(process.RawToDigi*process.mylocalreco*process.myglobalreco*process.ecalDrivenElectronSeedsEachRun*process.ecalDrivenElectronSeedsOnIov)
+
+process.outpath = cms.EndPath(process.out)
+process.GlobalTag.globaltag = os.environ['TEST_GLOBAL_TAG']+'::All'
@@ -0,0 +1,49 @@
+import FWCore.ParameterSet.Config as cms
+import os
+import dbs_discovery
+
+# Runs ElectronSeedProducer twice on the same events, with the whole initial
+# seed collection and with the phi roads, the products being then compared
+# with compareElectronSeeds.py, which fails if they differ. The Timing
+# service reports the time spent in each of the two modules.
+
+process = cms.Process("electrons")
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.Geometry_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.load("Configuration.StandardSequences.RawToDigi_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+process.load("RecoEgamma.EgammaElectronProducers.gsfElectronSequence_cff")
+
+process.source = cms.Source("PoolSource",
+    debugVerbosity = cms.untracked.uint32(1),
+    debugFlag = cms.untracked.bool(True),
+    fileNames = cms.untracked.vstring()
+)
+
+process.source.fileNames.extend(dbs_discovery.search())
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.Timing = cms.Service("Timing")
+
+process.ecalDrivenElectronSeeds.initialSeedsPhiRoads = False
+process.ecalDrivenElectronSeedsPhiRoads = process.ecalDrivenElectronSeeds.clone(
+    initialSeedsPhiRoads = True
+)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    outputCommands = cms.untracked.vstring('drop *',
+        'keep *_ecalDrivenElectronSeeds_*_electrons',
+        'keep *_ecalDrivenElectronSeedsPhiRoads_*_electrons'),
+    fileName = cms.untracked.string(os.environ['TEST_RECO_FILE'])
+)
+
+process.p = cms.Path(process.siPixelRecHits*process.siStripMatchedRecHits*process.newSeedFromPairs*process.newSeedFromTriplets*process.newCombinedSeeds*process.ecalDrivenElectronSeeds*process.ecalDrivenElectronSeedsPhiRoads)
+
+process.outpath = cms.EndPath(process.out)
+process.GlobalTag.globaltag = os.environ['TEST_GLOBAL_TAG']+'::All'
@@ -0,0 +1,10 @@
+import FWCore.ParameterSet.Config as cms
+
+# Takes the configuration written by cmsDriver.py (--no_exec) in
+# TwoRunsRaw.py, and makes its source change run every 5 events, so that
+# the following jobs see a run transition.
+
+from TwoRunsRaw import *
+
+process.source.numberEventsInRun = cms.untracked.uint32(5)
+process.maxEvents.input = cms.untracked.int32(10)
@@ -0,0 +1,46 @@
+import FWCore.ParameterSet.Config as cms
+import os
+import dbs_discovery
+
+# Runs SiStripElectronProducer twice on the same events, without and with
+# the hit index precheck, the products being then compared with
+# compareSiStripElectrons.py, which fails if they differ.
+
+process = cms.Process("electrons")
+
+process.load("Configuration.StandardSequences.Services_cff")
+process.load("Configuration.StandardSequences.Geometry_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("FWCore.MessageService.MessageLogger_cfi")
+
+process.load("Configuration.StandardSequences.RawToDigi_cff")
+process.load("Configuration.StandardSequences.Reconstruction_cff")
+
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+process.load("RecoEgamma.EgammaElectronProducers.siStripElectrons_cfi")
+
+process.source = cms.Source("PoolSource",
+    debugVerbosity = cms.untracked.uint32(1),
+    debugFlag = cms.untracked.bool(True),
+    fileNames = cms.untracked.vstring()
+)
+
+process.source.fileNames.extend(dbs_discovery.search())
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.siStripElectrons.hitIndexPrecheck = False
+process.siStripElectronsPrecheck = process.siStripElectrons.clone(
+    hitIndexPrecheck = True
+)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    outputCommands = cms.untracked.vstring('drop *',
+        'keep *_siStripElectrons_*_electrons',
+        'keep *_siStripElectronsPrecheck_*_electrons'),
+    fileName = cms.untracked.string(os.environ['TEST_RECO_FILE'])
+)
+
+process.p = cms.Path(process.siStripMatchedRecHits*process.siStripElectrons*process.siStripElectronsPrecheck)
+
+process.outpath = cms.EndPath(process.out)
+process.GlobalTag.globaltag = os.environ['TEST_GLOBAL_TAG']+'::All'